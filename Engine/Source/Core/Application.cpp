@@ -1,5 +1,6 @@
 #include "Application.h"
 #include "Networking/Server.h"
+#include <algorithm>
 #include <chrono>
 #include <iostream>
 #include <csignal>
@@ -68,14 +69,19 @@ namespace SquareCore
 
     void Application::PhysicsThreadFunction()
     {
+        const float fixedTimestep = 1.0f / tickRate;
+        auto nextTick = std::chrono::steady_clock::now();
         while (running)
         {
             // Update physics system
-            float effectiveTimestep = timeline.CalculateEffectiveTime(FIXED_TIMESTEP);
+            float effectiveTimestep = timeline.CalculateEffectiveTime(fixedTimestep);
             physics.Update(effectiveTimestep);
 
-            // Sleep to maintain 60 Hz update rate
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            // Sleep until the next tick to hold the tick rate, a late tick doesn't make the next ones rush
+            nextTick += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float>(fixedTimestep));
+            nextTick = std::max(nextTick, std::chrono::steady_clock::now());
+            std::this_thread::sleep_until(nextTick);
         }
     }
 
@@ -140,9 +146,18 @@ namespace SquareCore
             // Update game logic
             for (auto* script : scripts)
                 script->OnUpdate(effectiveDeltaTime);
+
+            // Apply spawns and removals the scripts deferred
+            entityManager.FlushCommands();
             
             input.EndFrame();
 
+            // Swap in a scene that finished loading in the background, at the frame boundary
+            sceneManager.Update();
+
+            // Bind sprites that finished loading in the background
+            entityManager.ProcessLoadedTextures();
+
             // Render the frame
             renderer.BeginFrame(effectiveDeltaTime, entityManager);
             renderer.RenderUI();
@@ -234,6 +249,19 @@ namespace SquareCore
             scripts.push_back(script);
     }
 
+    bool Application::SetTickRate(float ticksPerSecond)
+    {
+        // Physics and the server have to agree, so the server's range applies to both
+        if (!(ticksPerSecond > 0.0f && ticksPerSecond <= Server::MAX_TICK_RATE))
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid tick rate %f, must be above 0 and at most %f\n",
+                         ticksPerSecond, Server::MAX_TICK_RATE);
+            return false;
+        }
+        tickRate = ticksPerSecond;
+        return true;
+    }
+
     void Application::Run()
     {
         // Initialize engine systems
@@ -359,6 +387,12 @@ namespace SquareCore
 
         // Initialize server
         Server server;
+        server.SetTickRate(tickRate);
+        server.SetSendRate(sendRate);
+        if (!recordingPath.empty())
+        {
+            server.StartRecording(recordingPath);
+        }
 
         // Set up game references to server's systems
         for (auto* script : localScripts)
@@ -366,6 +400,7 @@ namespace SquareCore
             script->SetEntityManager(&server.GetEntityManager());
             script->SetPhysicsRef(&server.GetPhysics());
             script->SetTimeline(&server.GetTimeline());
+            script->SetSceneManager(&server.GetSceneManager());
             script->SetInputManager(&server.GetInputManager());
             script->SetMode(NetworkMode::SERVER);
             script->SetServerRef(&server);
@@ -510,6 +545,13 @@ namespace SquareCore
         }
     }
 
+    void Application::RunReplay(const std::string& replayPath, uint32_t viewAsClientID)
+    {
+        this->replayPath = replayPath;
+        replayClientId = viewAsClientID;
+        RunClient("");
+    }
+
     void Application::RunClient(const std::string& serverAddress)
     {
         // Initialize engine systems
@@ -547,9 +589,17 @@ namespace SquareCore
             std::this_thread::sleep_for(std::chrono::milliseconds(1));
         }
 
-        // Initialize NetworkManager and connect to server
+        // Initialize NetworkManager and connect to server, or play back a recorded session
         networkManager.SetEntityManager(&entityManager);
-        if (!networkManager.Connect(serverAddress))
+        if (!replayPath.empty())
+        {
+            if (!networkManager.StartReplay(replayPath, replayClientId))
+            {
+                std::cout << "Failed to start replay of " << replayPath << "\n";
+                return;
+            }
+        }
+        else if (!networkManager.Connect(serverAddress))
         {
             std::cout << "Failed to connect to server at " << serverAddress << "\n";
             return;
@@ -40,8 +40,17 @@ public:
     void RunServer(bool headless = true);
     // Starts the client loop with server connection
     void RunClient(const std::string& serverAddress);
+    // Starts the client loop playing back a recorded server session instead of connecting
+    void RunReplay(const std::string& replayPath, uint32_t viewAsClientID = 0);
     // Pushes a script to the script stack
     void PushScript(Script* script);
+    // Sets the fixed simulation rate in Hz for physics and the server (eg. 60, 120 or 128), the same range the
+    // server accepts. Returns false and keeps the current rate otherwise
+    bool SetTickRate(float ticksPerSecond);
+    // Sets how many snapshots per second the server sends each client, independent of the tick rate
+    void SetSendRate(float snapshotsPerSecond) { sendRate = snapshotsPerSecond; }
+    // Makes the server record its session to a file for later replay
+    void SetSessionRecording(const std::string& path) { recordingPath = path; }
 
     // Provides access to the entity manager
     EntityManager& GetEntityManager() { return entityManager; }
@@ -101,8 +110,15 @@ private:
     // Network thread function
     void NetworkThreadFunction();
 
-    // Fixed 60 Hz timestep for physics updates
-    static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+    // Fixed simulation rate for physics updates and the server tick
+    float tickRate = 60.0f;
+    // Server snapshot send rate
+    float sendRate = 60.0f;
+    // Session file the server records to
+    std::string recordingPath;
+    // Session file the client plays back instead of connecting, and whose view it takes
+    std::string replayPath;
+    uint32_t replayClientId = 0;
     // Maximum frame time for rendering
     static constexpr float MAX_FRAME_TIME = 0.25f;
 };
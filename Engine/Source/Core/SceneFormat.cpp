@@ -0,0 +1,346 @@
+#include "SceneFormat.h"
+#include "Renderer/Entity.h"
+#include <SDL3/SDL_log.h>
+#include <json/json.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace SquareCore
+{
+    const std::string& CompiledScene::GetString(uint32_t index) const {
+        static const std::string empty;
+        return index < strings.size() ? strings[index] : empty;
+    }
+
+    namespace
+    {
+        // Interns strings so repeated sprite paths and tags are stored once
+        class StringInterner {
+        public:
+            explicit StringInterner(std::vector<std::string>& strings) : strings(strings) {}
+
+            uint32_t Intern(const std::string& value) {
+                auto it = indices.find(value);
+                if (it != indices.end()) return it->second;
+                uint32_t index = static_cast<uint32_t>(strings.size());
+                strings.push_back(value);
+                indices.emplace(value, index);
+                return index;
+            }
+
+        private:
+            std::vector<std::string>& strings;
+            std::unordered_map<std::string, uint32_t> indices;
+        };
+
+        void ReadColor(const nlohmann::json& json, uint8_t out[4]) {
+            for (int i = 0; i < 4; ++i) {
+                out[i] = json[i].get<uint8_t>();
+            }
+        }
+
+        void WriteColor(const RGBA& color, uint8_t out[4]) {
+            out[0] = color.r;
+            out[1] = color.g;
+            out[2] = color.b;
+            out[3] = color.a;
+        }
+
+        uint32_t AddTags(const nlohmann::json& json, StringInterner& interner, std::vector<uint32_t>& tagRefs,
+                         uint32_t& tagCount) {
+            uint32_t tagStart = static_cast<uint32_t>(tagRefs.size());
+            tagCount = 0;
+            if (json.contains("tags")) {
+                for (const auto& tag : json["tags"]) {
+                    tagRefs.push_back(interner.Intern(tag.get<std::string>()));
+                    ++tagCount;
+                }
+            }
+            return tagStart;
+        }
+
+        template<typename T>
+        bool ReadArray(std::ifstream& file, std::vector<T>& out, uint32_t count) {
+            out.resize(count);
+            return count == 0 || static_cast<bool>(file.read(reinterpret_cast<char*>(out.data()), count * sizeof(T)));
+        }
+
+        template<typename T>
+        void WriteArray(std::ofstream& file, const std::vector<T>& values) {
+            if (!values.empty()) {
+                file.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+            }
+        }
+    }
+
+    bool SceneFormat::CompileJson(const std::string& filepath, CompiledScene& scene) {
+        std::ifstream file(filepath);
+        if (!file.is_open()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open scene file %s", filepath.c_str());
+            return false;
+        }
+
+        nlohmann::json sceneJson;
+        try {
+            sceneJson = nlohmann::json::parse(file, nullptr, true, true);
+        } catch (const nlohmann::json::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse scene JSON: %s", e.what());
+            return false;
+        }
+
+        scene = CompiledScene();
+        StringInterner interner(scene.strings);
+        std::unordered_map<uint32_t, uint32_t> spriteIndices;  // path string -> sprite table index
+
+        try {
+            if (sceneJson.contains("background-color")) {
+                std::vector<uint8_t> background_color = sceneJson["background-color"].get<std::vector<uint8_t>>();
+                scene.hasBackgroundColor = true;
+                scene.backgroundColor = RGBA(background_color[0], background_color[1], background_color[2], background_color[3]);
+            }
+
+            if (sceneJson.contains("entities")) {
+                scene.entities.reserve(sceneJson["entities"].size());
+                for (const auto& entityJson : sceneJson["entities"]) {
+                    SceneEntityRecord record = {};
+                    record.sprite = SCENE_NO_STRING;
+                    record.totalFrames = 1;
+                    record.scale[0] = record.scale[1] = 1.0f;
+                    WriteColor(RGBA(255, 255, 255, 255), record.color);
+                    WriteColor(RGBA(0, 0, 0, 255), record.spritelessColor);
+                    record.mass = 1.0f;
+                    record.colliderType = static_cast<int32_t>(ColliderType::SOLID);
+                    record.flags = SCENE_ENTITY_VISIBLE | SCENE_ENTITY_COLLIDER_ENABLED;
+
+                    if (entityJson.contains("position")) {
+                        record.position[0] = entityJson["position"][0];
+                        record.position[1] = entityJson["position"][1];
+                    }
+                    record.rotation = entityJson.value("rotation", 0.0f);
+                    if (entityJson.contains("scale")) {
+                        record.scale[0] = entityJson["scale"][0];
+                        record.scale[1] = entityJson["scale"][1];
+                    }
+                    record.zIndex = entityJson.value("zIndex", 0);
+
+                    if (entityJson.value("isSpriteless", false)) {
+                        record.flags |= SCENE_ENTITY_SPRITELESS;
+                        record.spritelessSize[0] = entityJson.value("spritelessWidth", 10.0f);
+                        record.spritelessSize[1] = entityJson.value("spritelessHeight", 10.0f);
+                        ReadColor(entityJson["spritelessColor"], record.spritelessColor);
+                    } else {
+                        uint32_t path = interner.Intern(entityJson.value("spritePath", ""));
+                        auto spriteIt = spriteIndices.find(path);
+                        if (spriteIt == spriteIndices.end()) {
+                            spriteIt = spriteIndices.emplace(path, static_cast<uint32_t>(scene.sprites.size())).first;
+                            scene.sprites.push_back({ path, 0.0f, 0.0f });
+                        }
+                        record.sprite = spriteIt->second;
+                        record.totalFrames = entityJson.value("totalFrames", 1);
+                        record.fps = entityJson.value("fps", 0.0f);
+                    }
+
+                    if (entityJson.value("flipX", false)) record.flags |= SCENE_ENTITY_FLIP_X;
+                    if (entityJson.value("flipY", false)) record.flags |= SCENE_ENTITY_FLIP_Y;
+                    if (!entityJson.value("visible", true)) record.flags &= ~SCENE_ENTITY_VISIBLE;
+                    if (entityJson.value("physApplied", false)) record.flags |= SCENE_ENTITY_PHYSICS;
+                    record.mass = entityJson.value("mass", 1.0f);
+                    record.drag = entityJson.value("drag", 0.0f);
+
+                    if (entityJson.contains("color")) {
+                        ReadColor(entityJson["color"], record.color);
+                    }
+
+                    if (entityJson.contains("collider")) {
+                        const auto& colliderJson = entityJson["collider"];
+                        record.colliderType = colliderJson.value("type", record.colliderType);
+                        if (!colliderJson.value("enabled", true)) record.flags &= ~SCENE_ENTITY_COLLIDER_ENABLED;
+                        if (colliderJson.contains("offset")) {
+                            record.colliderOffset[0] = colliderJson["offset"][0];
+                            record.colliderOffset[1] = colliderJson["offset"][1];
+                        }
+                        if (colliderJson.contains("size")) {
+                            record.colliderSize[0] = colliderJson["size"][0];
+                            record.colliderSize[1] = colliderJson["size"][1];
+                        }
+                    }
+
+                    record.tagStart = AddTags(entityJson, interner, scene.tagRefs, record.tagCount);
+                    scene.entities.push_back(record);
+                }
+            }
+
+            if (sceneJson.contains("ui")) {
+                for (const auto& uiJson : sceneJson["ui"]) {
+                    SceneUIRecord record = {};
+                    record.type = uiJson.value("type", 0);
+                    record.x = uiJson.value("x", 0.0f);
+                    record.y = uiJson.value("y", 0.0f);
+                    record.width = uiJson.value("width", 100.0f);
+                    record.height = uiJson.value("height", 50.0f);
+                    record.zIndex = uiJson.value("zIndex", 0);
+                    if (uiJson.value("visible", true)) record.flags |= SCENE_UI_VISIBLE;
+
+                    WriteColor(RGBA(255, 255, 255, 255), record.color);
+                    if (uiJson.contains("color")) {
+                        ReadColor(uiJson["color"], record.color);
+                    }
+
+                    WriteColor(RGBA(0, 0, 0, 255), record.borderColor);
+                    record.borderThickness = 1.0f;
+                    if (uiJson.contains("border")) {
+                        if (uiJson["border"].contains("color")) {
+                            ReadColor(uiJson["border"]["color"], record.borderColor);
+                        }
+                        record.borderThickness = uiJson["border"].value("thickness", 1.0f);
+                        record.borderRadius = uiJson["border"].value("radius", 0.0f);
+                    }
+
+                    record.textContent = SCENE_NO_STRING;
+                    record.fontPath = SCENE_NO_STRING;
+                    record.fontSize = 16.0f;
+                    WriteColor(RGBA(0, 0, 0, 255), record.textColor);
+                    if (uiJson.contains("text")) {
+                        record.textContent = interner.Intern(uiJson["text"].value("content", ""));
+                        record.fontPath = interner.Intern(uiJson["text"].value("fontPath", ""));
+                        record.fontSize = uiJson["text"].value("fontSize", 16.0f);
+                        if (uiJson["text"].contains("color")) {
+                            ReadColor(uiJson["text"]["color"], record.textColor);
+                        }
+                    }
+
+                    record.tagStart = AddTags(uiJson, interner, scene.tagRefs, record.tagCount);
+                    scene.ui.push_back(record);
+                }
+            }
+        } catch (const nlohmann::json::exception& e) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid scene %s: %s", filepath.c_str(), e.what());
+            return false;
+        }
+
+        return true;
+    }
+
+    bool SceneFormat::WriteBinary(const std::string& filepath, const CompiledScene& scene) {
+        std::filesystem::path path(filepath);
+        if (path.has_parent_path()) {
+            std::filesystem::create_directories(path.parent_path());
+        }
+
+        std::ofstream file(filepath, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to write cooked scene %s", filepath.c_str());
+            return false;
+        }
+
+        std::vector<uint32_t> stringOffsets;
+        stringOffsets.reserve(scene.strings.size() + 1);
+        uint32_t stringBytes = 0;
+        for (const std::string& value : scene.strings) {
+            stringOffsets.push_back(stringBytes);
+            stringBytes += static_cast<uint32_t>(value.size());
+        }
+        stringOffsets.push_back(stringBytes);
+
+        SceneFileHeader header = {};
+        std::memcpy(header.magic, MAGIC, sizeof(header.magic));
+        header.version = VERSION;
+        header.flags = scene.hasBackgroundColor ? FLAG_BACKGROUND_COLOR : 0;
+        WriteColor(scene.backgroundColor, header.backgroundColor);
+        header.stringCount = static_cast<uint32_t>(scene.strings.size());
+        header.stringBytes = stringBytes;
+        header.spriteCount = static_cast<uint32_t>(scene.sprites.size());
+        header.entityCount = static_cast<uint32_t>(scene.entities.size());
+        header.tagRefCount = static_cast<uint32_t>(scene.tagRefs.size());
+        header.uiCount = static_cast<uint32_t>(scene.ui.size());
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        WriteArray(file, stringOffsets);
+        for (const std::string& value : scene.strings) {
+            file.write(value.data(), value.size());
+        }
+        WriteArray(file, scene.sprites);
+        WriteArray(file, scene.entities);
+        WriteArray(file, scene.tagRefs);
+        WriteArray(file, scene.ui);
+
+        return static_cast<bool>(file);
+    }
+
+    bool SceneFormat::ReadBinary(const std::string& filepath, CompiledScene& scene) {
+        std::ifstream file(filepath, std::ios::binary);
+        if (!file.is_open()) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open cooked scene %s", filepath.c_str());
+            return false;
+        }
+
+        SceneFileHeader header = {};
+        if (!file.read(reinterpret_cast<char*>(&header), sizeof(header)) ||
+            std::memcmp(header.magic, MAGIC, sizeof(header.magic)) != 0) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "%s is not a cooked scene", filepath.c_str());
+            return false;
+        }
+        if (header.version != VERSION) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cooked scene %s has version %u, expected %u, re-cook it",
+                         filepath.c_str(), header.version, VERSION);
+            return false;
+        }
+
+        // The counts come from the file, so check they add up to its size before allocating anything for them.
+        // Everything is summed in 64 bits so no count can wrap
+        std::streampos dataStart = file.tellg();
+        file.seekg(0, std::ios::end);
+        uint64_t dataBytes = static_cast<uint64_t>(file.tellg()) - static_cast<uint64_t>(dataStart);
+        file.seekg(dataStart);
+        uint64_t expectedBytes = (static_cast<uint64_t>(header.stringCount) + 1) * sizeof(uint32_t) +
+                                 header.stringBytes +
+                                 static_cast<uint64_t>(header.spriteCount) * sizeof(SceneSpriteRecord) +
+                                 static_cast<uint64_t>(header.entityCount) * sizeof(SceneEntityRecord) +
+                                 static_cast<uint64_t>(header.tagRefCount) * sizeof(uint32_t) +
+                                 static_cast<uint64_t>(header.uiCount) * sizeof(SceneUIRecord);
+        if (expectedBytes != dataBytes) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cooked scene %s is truncated or corrupt (%llu bytes, header expects %llu)",
+                         filepath.c_str(), static_cast<unsigned long long>(dataBytes),
+                         static_cast<unsigned long long>(expectedBytes));
+            return false;
+        }
+
+        scene = CompiledScene();
+        scene.hasBackgroundColor = (header.flags & FLAG_BACKGROUND_COLOR) != 0;
+        scene.backgroundColor = RGBA(header.backgroundColor[0], header.backgroundColor[1],
+                                     header.backgroundColor[2], header.backgroundColor[3]);
+
+        std::vector<uint32_t> stringOffsets;
+        std::string stringData(header.stringBytes, '\0');
+        bool ok = ReadArray(file, stringOffsets, header.stringCount + 1) &&
+                  (header.stringBytes == 0 || file.read(stringData.data(), header.stringBytes)) &&
+                  ReadArray(file, scene.sprites, header.spriteCount) &&
+                  ReadArray(file, scene.entities, header.entityCount) &&
+                  ReadArray(file, scene.tagRefs, header.tagRefCount) &&
+                  ReadArray(file, scene.ui, header.uiCount);
+        if (!ok) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cooked scene %s is truncated", filepath.c_str());
+            return false;
+        }
+
+        scene.strings.reserve(header.stringCount);
+        for (uint32_t i = 0; i < header.stringCount; ++i) {
+            uint32_t start = stringOffsets[i];
+            uint32_t end = stringOffsets[i + 1];
+            if (start > end || end > header.stringBytes) {
+                SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Cooked scene %s has a corrupt string table", filepath.c_str());
+                return false;
+            }
+            scene.strings.emplace_back(stringData, start, end - start);
+        }
+        return true;
+    }
+
+    std::string SceneFormat::GetCookedPath(const std::string& filepath) {
+        std::filesystem::path path(filepath);
+        path.replace_extension(".squareb");
+        return path.string();
+    }
+}
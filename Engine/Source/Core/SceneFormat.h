@@ -0,0 +1,130 @@
+#pragma once
+
+#include "UI/Color.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SquareCore {
+
+// Compiled form of a .square scene, shared by the JSON loader and the binary .squareb format.
+// Strings are interned into one table and referenced by index, records are fixed-size and
+// the .squareb file stores each array as-is so loading is a handful of bulk reads.
+//
+// .squareb layout (little-endian):
+//   SceneFileHeader
+//   uint32 stringOffsets[stringCount + 1], then stringBytes of characters
+//   SceneSpriteRecord[spriteCount]
+//   SceneEntityRecord[entityCount]
+//   uint32 tagRefs[tagRefCount]
+//   SceneUIRecord[uiCount]
+
+inline constexpr uint32_t SCENE_NO_STRING = 0xFFFFFFFFu;
+
+struct SceneFileHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t flags;
+    uint8_t backgroundColor[4];
+    uint32_t stringCount;
+    uint32_t stringBytes;
+    uint32_t spriteCount;
+    uint32_t entityCount;
+    uint32_t tagRefCount;
+    uint32_t uiCount;
+};
+
+// A sprite sheet used by the scene, its size is filled in by the cooker so colliders can be
+// sized without decoding the image (0 when unknown)
+struct SceneSpriteRecord {
+    uint32_t path;
+    float width;
+    float height;
+};
+
+enum SceneEntityFlags : uint32_t {
+    SCENE_ENTITY_SPRITELESS = 1u << 0,
+    SCENE_ENTITY_FLIP_X = 1u << 1,
+    SCENE_ENTITY_FLIP_Y = 1u << 2,
+    SCENE_ENTITY_VISIBLE = 1u << 3,
+    SCENE_ENTITY_PHYSICS = 1u << 4,
+    SCENE_ENTITY_COLLIDER_ENABLED = 1u << 5,
+};
+
+struct SceneEntityRecord {
+    uint32_t flags;
+    uint32_t sprite;            // Index into the sprite table, SCENE_NO_STRING for spriteless entities
+    int32_t totalFrames;
+    float fps;
+    float position[2];
+    float rotation;
+    float scale[2];
+    uint8_t color[4];
+    uint8_t spritelessColor[4];
+    float spritelessSize[2];
+    int32_t zIndex;
+    float mass;
+    float drag;
+    int32_t colliderType;
+    float colliderOffset[2];
+    float colliderSize[2];
+    uint32_t tagStart;          // Range in the tag reference array
+    uint32_t tagCount;
+};
+
+enum SceneUIFlags : uint32_t {
+    SCENE_UI_VISIBLE = 1u << 0,
+};
+
+struct SceneUIRecord {
+    uint32_t flags;
+    int32_t type;
+    float x;
+    float y;
+    float width;
+    float height;
+    int32_t zIndex;
+    uint8_t color[4];
+    uint8_t borderColor[4];
+    float borderThickness;
+    float borderRadius;
+    uint32_t textContent;
+    uint32_t fontPath;
+    float fontSize;
+    uint8_t textColor[4];
+    uint32_t tagStart;
+    uint32_t tagCount;
+};
+
+static_assert(sizeof(SceneFileHeader) == 40, "SceneFileHeader must stay tightly packed");
+static_assert(sizeof(SceneSpriteRecord) == 12, "SceneSpriteRecord must stay tightly packed");
+static_assert(sizeof(SceneEntityRecord) == 92, "SceneEntityRecord must stay tightly packed");
+static_assert(sizeof(SceneUIRecord) == 68, "SceneUIRecord must stay tightly packed");
+
+struct CompiledScene {
+    bool hasBackgroundColor = false;
+    RGBA backgroundColor;
+    std::vector<std::string> strings;
+    std::vector<SceneSpriteRecord> sprites;
+    std::vector<SceneEntityRecord> entities;
+    std::vector<uint32_t> tagRefs;
+    std::vector<SceneUIRecord> ui;
+
+    const std::string& GetString(uint32_t index) const;
+};
+
+namespace SceneFormat {
+    inline constexpr char MAGIC[4] = { 'S', 'Q', 'S', 'B' };
+    inline constexpr uint32_t VERSION = 1;
+    inline constexpr uint32_t FLAG_BACKGROUND_COLOR = 1u << 0;
+
+    // Parses a .square JSON scene into compiled form
+    bool CompileJson(const std::string& filepath, CompiledScene& scene);
+    // Writes and reads the binary .squareb form
+    bool WriteBinary(const std::string& filepath, const CompiledScene& scene);
+    bool ReadBinary(const std::string& filepath, CompiledScene& scene);
+    // The cooked file next to a .square scene (level1.square -> level1.squareb)
+    std::string GetCookedPath(const std::string& filepath);
+}
+
+}
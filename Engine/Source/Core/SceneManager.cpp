@@ -1,12 +1,25 @@
 #include "SceneManager.h"
 #include "UI/UIElement.h"
 #include <SDL3/SDL_log.h>
+#include <SDL3_image/SDL_image.h>
 #include <json/json.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <filesystem>
 #include <fstream>
+#include <unordered_map>
 
 namespace SquareCore
 {
+    namespace {
+        float DistanceToChunk(const Vec2& min, const Vec2& max, const Vec2& point) {
+            float dx = std::max({min.x - point.x, 0.0f, point.x - max.x});
+            float dy = std::max({min.y - point.y, 0.0f, point.y - max.y});
+            return std::sqrt(dx * dx + dy * dy);
+        }
+    }
+
     bool SceneManager::SaveScene(const std::string& filepath) {
         nlohmann::json sceneJson;
 
@@ -72,7 +85,8 @@ namespace SquareCore
             }
             if (!colliderJson.empty()) entityJson["collider"] = colliderJson;
             
-            if (!entity.tags.empty()) entityJson["tags"] = entity.tags;
+            std::vector<std::string> tags = entity.GetAllTags();
+            if (!tags.empty()) entityJson["tags"] = tags;
 
             sceneJson["entities"].push_back(entityJson);
         }
@@ -145,21 +159,157 @@ namespace SquareCore
         return true;
     }
 
+    bool SceneManager::ReadScene(const std::string& filepath, CompiledScene& scene) {
+        std::filesystem::path path(filepath);
+        if (path.extension() == ".squareb") {
+            return SceneFormat::ReadBinary(filepath, scene);
+        }
+
+        // Prefer the cooked scene next to the JSON while it is at least as new as the JSON
+        std::error_code error;
+        std::string cookedPath = SceneFormat::GetCookedPath(filepath);
+        auto cookedTime = std::filesystem::last_write_time(cookedPath, error);
+        if (!error) {
+            auto sourceTime = std::filesystem::last_write_time(path, error);
+            if ((error || cookedTime >= sourceTime) && SceneFormat::ReadBinary(cookedPath, scene)) {
+                return true;
+            }
+        }
+        return SceneFormat::CompileJson(filepath, scene);
+    }
+
     bool SceneManager::LoadScene(const std::string& filepath) {
-        std::ifstream file(filepath);
-        if (!file.is_open()) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to open scene file %s", filepath.c_str());
+        CancelAsyncLoad();
+
+        CompiledScene scene;
+        if (!ReadScene(filepath, scene)) {
             return false;
         }
-        
-        nlohmann::json sceneJson;
-        try {
-            sceneJson = nlohmann::json::parse(file, nullptr, true, true);
-        } catch (const nlohmann::json::exception& e) {
-            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Failed to parse scene JSON: %s", e.what());
-            return false;
+        CommitScene(scene, BuildEntities(scene));
+        return true;
+    }
+
+    bool SceneManager::LoadSceneAsync(const std::string& filepath, std::function<void(bool)> onLoaded) {
+        CancelAsyncLoad();
+
+        asyncLoad.active = true;
+        asyncLoad.filepath = filepath;
+        asyncLoad.onLoaded = std::move(onLoaded);
+        asyncLoad.ready = false;
+        asyncLoad.cancelled = false;
+        asyncLoad.succeeded = false;
+        asyncLoad.uploadedSurfaces = 0;
+        asyncLoad.loaderThread = std::thread(&SceneManager::LoaderThread, this);
+        return true;
+    }
+
+    void SceneManager::LoaderThread() {
+        asyncLoad.succeeded = ReadScene(asyncLoad.filepath, asyncLoad.scene);
+        if (asyncLoad.succeeded && !asyncLoad.cancelled) {
+            asyncLoad.entities = BuildEntities(asyncLoad.scene);
+
+            // Decode every sheet the texture cache doesn't have yet so the swap never touches the disk
+            std::unordered_map<std::string, SDL_Surface*> decoded;
+            for (Entity& entity : asyncLoad.entities) {
+                if (asyncLoad.cancelled) break;
+                if (entity.isSpriteless) continue;
+
+                auto it = decoded.find(entity.spritePath);
+                if (it == decoded.end()) {
+                    SDL_Surface* surface = nullptr;
+                    if (!entityManagerRef || !entityManagerRef->HasSharedTexture(entity.spritePath)) {
+                        surface = IMG_Load(entity.spritePath.c_str());
+                        if (!surface) {
+                            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load sprite %s: %s",
+                                         entity.spritePath.c_str(), SDL_GetError());
+                        }
+                        asyncLoad.surfaces.emplace_back(entity.spritePath, surface);
+                    }
+                    it = decoded.emplace(entity.spritePath, surface).first;
+                }
+                // Sizes collider definitions up front, cached sprites are sized when the entities are inserted
+                if (it->second) {
+                    entity.spriteWidth = static_cast<float>(it->second->w);
+                    entity.spriteHeight = static_cast<float>(it->second->h);
+                }
+            }
         }
-        
+        asyncLoad.ready = true;
+    }
+
+    void SceneManager::CancelAsyncLoad() {
+        if (!asyncLoad.active) {
+            return;
+        }
+
+        asyncLoad.cancelled = true;
+        if (asyncLoad.loaderThread.joinable()) {
+            asyncLoad.loaderThread.join();
+        }
+        for (size_t i = asyncLoad.uploadedSurfaces; i < asyncLoad.surfaces.size(); ++i) {
+            if (asyncLoad.surfaces[i].second) {
+                SDL_DestroySurface(asyncLoad.surfaces[i].second);
+            }
+        }
+
+        asyncLoad.active = false;
+        asyncLoad.onLoaded = nullptr;
+        asyncLoad.scene = CompiledScene();
+        asyncLoad.entities.clear();
+        asyncLoad.surfaces.clear();
+        asyncLoad.uploadedSurfaces = 0;
+    }
+
+    SceneManager::~SceneManager() {
+        CancelAsyncLoad();
+
+        chunkTextureLoader.Shutdown();
+        for (auto& [spritePath, surface] : decodedChunkTextures) {
+            if (surface) {
+                SDL_DestroySurface(surface);
+            }
+        }
+    }
+
+    void SceneManager::Update(float budgetMs) {
+        AdvanceAsyncLoad(budgetMs);
+        UpdateStreaming(budgetMs);
+    }
+
+    void SceneManager::AdvanceAsyncLoad(float budgetMs) {
+        if (!asyncLoad.active || !asyncLoad.ready) {
+            return;
+        }
+        if (asyncLoad.loaderThread.joinable()) {
+            asyncLoad.loaderThread.join();
+        }
+
+        // Uploads are spread over frames, the old scene keeps running until every sprite is resident
+        if (asyncLoad.succeeded && entityManagerRef) {
+            auto start = std::chrono::steady_clock::now();
+            while (asyncLoad.uploadedSurfaces < asyncLoad.surfaces.size()) {
+                if (std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs) {
+                    return;
+                }
+                auto& [spritePath, surface] = asyncLoad.surfaces[asyncLoad.uploadedSurfaces++];
+                entityManagerRef->AddSharedTexture(spritePath, surface);
+                surface = nullptr;
+            }
+        }
+
+        bool succeeded = asyncLoad.succeeded;
+        if (succeeded) {
+            CommitScene(asyncLoad.scene, std::move(asyncLoad.entities));
+        }
+
+        std::function<void(bool)> onLoaded = std::move(asyncLoad.onLoaded);
+        CancelAsyncLoad();
+        if (onLoaded) {
+            onLoaded(succeeded);
+        }
+    }
+
+    void SceneManager::CommitScene(const CompiledScene& scene, std::vector<Entity>&& entities) {
         if (physicsRef)
         {
             physicsRef->ClearBodies();
@@ -172,175 +322,302 @@ namespace SquareCore
         {
             uiManagerRef->ClearElements();
         }
-        if (sceneJson.contains("background-color"))
+        if (scene.hasBackgroundColor && rendererRef)
         {
+            rendererRef->SetBackgroundColor(scene.backgroundColor);
+        }
+        PartitionChunks(entities);
+        if (entityManagerRef)
+        {
+            entityManagerRef->CreateBatch(std::move(entities));
+
+            // Chunks already in range come in with the scene, the rest stream in as the camera moves
             if (rendererRef)
             {
-                std::vector<uint8_t> background_color = sceneJson["background-color"].get<std::vector<uint8_t>>();
-                rendererRef->SetBackgroundColor(RGBA(background_color[0], background_color[1], background_color[2], background_color[3]));
+                Vec2 focus = rendererRef->GetCamera().GetPosition();
+                for (SceneChunk& chunk : chunks) {
+                    if (DistanceToChunk(chunk.min, chunk.max, focus) <= chunkLoadRadius) {
+                        LoadChunk(chunk);
+                    }
+                }
             }
         }
-        if (sceneJson.contains("entities")) {
-            for (const auto& entityJson : sceneJson["entities"]) {
-                uint32_t id;
-
-                bool isSpriteless = entityJson.value("isSpriteless", false);
-                float posX = 0.0f;
-                float posY = 0.0f;
-                if (entityJson.contains("position"))
-                {
-                    posX = entityJson["position"][0];
-                    posY = entityJson["position"][1];
-                }
-                float rotation = entityJson.value("rotation", 0.0f);
-                float scaleX = 1.0f;
-                float scaleY = 1.0f;
-                if (entityJson.contains("scale")) {
-                    scaleX = entityJson["scale"][0];
-                    scaleY = entityJson["scale"][1];
-                }
-                int zIndex = entityJson["zIndex"];
+        if (uiManagerRef)
+        {
+            InstantiateUI(scene);
+        }
 
-                std::vector<std::string> tags;
-                if (entityJson.contains("tags")) {
-                    tags = entityJson["tags"].get<std::vector<std::string>>();
-                }
+        // Merge the scene's static tiles into shared bodies once they've been created
+        if (physicsRef)
+        {
+            physicsRef->RequestStaticBake();
+        }
+    }
 
-                if (isSpriteless) {
-                    float width = entityJson.value("spritelessWidth", 10.0f);
-                    float height = entityJson.value("spritelessHeight", 10.0f);
-                    RGBA color(
-                        entityJson["spritelessColor"][0],
-                        entityJson["spritelessColor"][1],
-                        entityJson["spritelessColor"][2],
-                        entityJson["spritelessColor"][3]
-                    );
-                    id = entityManagerRef->AddSpritelessEntity(width, height, color, posX, posY, rotation, scaleX, scaleY);
-                } else {
-                    std::string spritePath = entityJson.value("spritePath", "");
-                    int totalFrames = entityJson.value("totalFrames", 1);
-                    float fps = entityJson.value("fps", 0.0f);
-
-                    if (totalFrames > 1 || fps > 0) {
-                        id = entityManagerRef->AddAnimatedEntity(spritePath.c_str(), totalFrames, fps, posX, posY, rotation, scaleX,
-                                                                 scaleY, false, tags);
-                    } else {
-                        id = entityManagerRef->AddEntity(spritePath.c_str(), posX, posY, rotation, scaleX, scaleY, false, tags);
-                    }
-                }
+    void SceneManager::SetStreaming(float chunkSize, float loadRadius, float unloadRadius) {
+        if (chunkSize < 0.0f || loadRadius < 0.0f || unloadRadius < loadRadius) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Invalid streaming settings: chunk %f, load %f, unload %f",
+                         chunkSize, loadRadius, unloadRadius);
+            return;
+        }
+        this->chunkSize = chunkSize;
+        chunkLoadRadius = loadRadius;
+        chunkUnloadRadius = unloadRadius;
+    }
 
-                Entity* entity = entityManagerRef->GetEntityByID(id);
-                if (entity) {
-                    entity->flipX = entityJson.value("flipX", false);
-                    entity->flipY = entityJson.value("flipY", false);
-                    entity->visible = entityJson.value("visible", true);
-                    entity->mass = entityJson.value("mass", 1.0f);
-                    entity->drag = entityJson.value("drag", 0.0f);
-                    entity->tags = tags;
-                    entity->zIndex = zIndex;
-                    
-                    if (entityJson.contains("physApplied"))
-                    {
-                        entityManagerRef->SetPhysicsEnabled(id, entityJson["physApplied"].get<bool>());
-                    }
+    size_t SceneManager::GetLoadedChunkCount() const {
+        size_t loaded = 0;
+        for (const SceneChunk& chunk : chunks) {
+            if (chunk.loaded) ++loaded;
+        }
+        return loaded;
+    }
 
-                    if (entityJson.contains("color")) {
-                        entity->color = RGBA(
-                            entityJson["color"][0],
-                            entityJson["color"][1],
-                            entityJson["color"][2],
-                            entityJson["color"][3]
-                        );
-                    }
+    void SceneManager::PartitionChunks(std::vector<Entity>& entities) {
+        chunks.clear();
+        failedChunkTextures.clear();
+        // Streaming follows the camera, without a renderer (dedicated server) everything stays resident
+        if (chunkSize <= 0.0f || !entityManagerRef || !rendererRef) {
+            return;
+        }
 
-                    if (entityJson.contains("collider")) {
-                        if (entityJson["collider"].contains("type")) {
-                            entityManagerRef->SetColliderType(id, static_cast<ColliderType>(entityJson["collider"]["type"].get<int>()));
-                        }
-                        if (entityJson["collider"].contains("enabled")) {
-                            entity->collider.enabled = entityJson["collider"]["enabled"].get<bool>();
-                        }
-                        if (entityJson["collider"].contains("offset")) {
-                            entity->collider.offset = Vec2(entityJson["collider"]["offset"][0],
-                                                           entityJson["collider"]["offset"][1]);
-                        }
-                        if (entityJson["collider"].contains("size")) {
-                            entity->collider.size = Vec2(entityJson["collider"]["size"][0],
-                                                         entityJson["collider"]["size"][1]);
-                        }
-                    }
-                }
+        std::unordered_map<int64_t, size_t> cellToChunk;
+        std::vector<Entity> resident;
+        for (Entity& entity : entities) {
+            if (entity.physApplied || entity.persistent) {
+                resident.push_back(std::move(entity));
+                continue;
+            }
+
+            int32_t cellX = static_cast<int32_t>(std::floor(entity.position.x / chunkSize));
+            int32_t cellY = static_cast<int32_t>(std::floor(entity.position.y / chunkSize));
+            int64_t key = (static_cast<int64_t>(cellX) << 32) | static_cast<uint32_t>(cellY);
+
+            auto it = cellToChunk.find(key);
+            if (it == cellToChunk.end()) {
+                SceneChunk& chunk = chunks.emplace_back();
+                chunk.min = Vec2(cellX * chunkSize, cellY * chunkSize);
+                chunk.max = chunk.min + Vec2(chunkSize, chunkSize);
+                it = cellToChunk.emplace(key, chunks.size() - 1).first;
             }
+            chunks[it->second].entities.push_back(std::move(entity));
         }
-        
-        if (sceneJson.contains("ui")) {
-            for (const auto& uiJson : sceneJson["ui"]) {
-                UIElementType type = static_cast<UIElementType>(uiJson.value("type", 0));
-                
-                if (type == UIElementType::BUTTON) continue;
-
-                uint32_t id;
-                float x = uiJson.value("x", 0.0f);
-                float y = uiJson.value("y", 0.0f);
-                float width = uiJson.value("width", 100.0f);
-                float height = uiJson.value("height", 50.0f);
-
-                RGBA color(255, 255, 255, 255);
-                if (uiJson.contains("color")) {
-                    color = RGBA(uiJson["color"][0], uiJson["color"][1], uiJson["color"][2], uiJson["color"][3]);
+        entities = std::move(resident);
+
+        // IDs are handed out up front so scripts can hold on to streamed entities across reloads
+        for (SceneChunk& chunk : chunks) {
+            uint32_t nextID = entityManagerRef->ReserveEntityIDs(static_cast<uint32_t>(chunk.entities.size()));
+            std::unordered_set<std::string> spritePaths;
+            for (Entity& entity : chunk.entities) {
+                entity.ID = nextID++;
+                chunk.entityIDs.push_back(entity.ID);
+                if (!entity.isSpriteless && spritePaths.insert(entity.spritePath).second) {
+                    chunk.spritePaths.push_back(entity.spritePath);
                 }
+            }
+        }
+    }
 
-                Border border;
-                if (uiJson.contains("border")) {
-                    if (uiJson["border"].contains("color")) {
-                        border.color = RGBA(
-                            uiJson["border"]["color"][0],
-                            uiJson["border"]["color"][1],
-                            uiJson["border"]["color"][2],
-                            uiJson["border"]["color"][3]
-                        );
-                    }
-                    border.thickness = uiJson["border"].value("thickness", 1.0f);
-                    border.radius = uiJson["border"].value("radius", 0.0f);
+    void SceneManager::UpdateStreaming(float budgetMs) {
+        if (chunks.empty() || !entityManagerRef || !rendererRef) {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        auto overBudget = [&start, budgetMs] {
+            return std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs;
+        };
+
+        std::vector<std::pair<std::string, SDL_Surface*>> decoded = chunkTextureLoader.TakeDecoded();
+        decodedChunkTextures.insert(decodedChunkTextures.end(), decoded.begin(), decoded.end());
+        size_t processed = 0;
+        while (processed < decodedChunkTextures.size() && !overBudget()) {
+            auto& [spritePath, surface] = decodedChunkTextures[processed++];
+            if (!surface) {
+                failedChunkTextures.insert(spritePath);
+            }
+            entityManagerRef->AddSharedTexture(spritePath, surface);
+            surface = nullptr;
+            pendingChunkTextures.erase(spritePath);
+            chunkTextureLoader.Forget(spritePath);
+        }
+        decodedChunkTextures.erase(decodedChunkTextures.begin(), decodedChunkTextures.begin() + processed);
+
+        // Chunks load inside loadRadius and unload past unloadRadius, the gap keeps them from flickering at the edge
+        Vec2 focus = rendererRef->GetCamera().GetPosition();
+        bool unloaded = false;
+        bool changed = false;
+        std::unordered_set<std::string> wantedTextures;
+        for (SceneChunk& chunk : chunks) {
+            float distance = DistanceToChunk(chunk.min, chunk.max, focus);
+            if (chunk.loaded && distance > chunkUnloadRadius) {
+                UnloadChunk(chunk);
+                unloaded = true;
+                changed = true;
+            }
+            else if (!chunk.loaded && distance <= chunkLoadRadius) {
+                if (ChunkTexturesReady(chunk) && !overBudget()) {
+                    LoadChunk(chunk);
+                    changed = true;
+                }
+                else {
+                    wantedTextures.insert(chunk.spritePaths.begin(), chunk.spritePaths.end());
                 }
+            }
+        }
 
-                std::string textContent = "";
-                std::string fontPath = "";
-                float fontSize = 16.0f;
-                RGBA textColor(0, 0, 0, 255);
-
-                if (uiJson.contains("text")) {
-                    textContent = uiJson["text"].value("content", "");
-                    fontPath = uiJson["text"].value("fontPath", "");
-                    fontSize = uiJson["text"].value("fontSize", 16.0f);
-                    if (uiJson["text"].contains("color")) {
-                        textColor = RGBA(
-                            uiJson["text"]["color"][0],
-                            uiJson["text"]["color"][1],
-                            uiJson["text"]["color"][2],
-                            uiJson["text"]["color"][3]
-                        );
+        // Textures a pending scene load reuses or has already uploaded have no entities yet, keep them too.
+        // The loader thread is still checking the cache until it is ready, so the release waits for it
+        textureReleasePending = textureReleasePending || unloaded;
+        if (textureReleasePending && !(asyncLoad.active && !asyncLoad.ready)) {
+            if (asyncLoad.active) {
+                for (const Entity& entity : asyncLoad.entities) {
+                    if (!entity.isSpriteless) {
+                        wantedTextures.insert(entity.spritePath);
                     }
                 }
+            }
+            entityManagerRef->ReleaseUnusedSharedTextures(wantedTextures);
+            textureReleasePending = false;
+        }
+        // Re-merge static geometry, bodies of unloaded tiles were split off their shared bodies
+        if (changed && physicsRef) {
+            physicsRef->RequestStaticBake();
+        }
+    }
 
-                if (type == UIElementType::TEXT) {
-                    id = uiManagerRef->AddText(x, y, fontSize, textColor, fontPath, textContent);
-                } else {
-                    id = uiManagerRef->AddRect(x, y, width, height, color, textContent, border, fontPath, fontSize, textColor);
-                }
+    bool SceneManager::ChunkTexturesReady(const SceneChunk& chunk) {
+        bool ready = true;
+        for (const std::string& spritePath : chunk.spritePaths) {
+            if (failedChunkTextures.count(spritePath) || entityManagerRef->HasSharedTexture(spritePath)) {
+                continue;
+            }
+            ready = false;
+            if (pendingChunkTextures.insert(spritePath).second) {
+                chunkTextureLoader.Request(spritePath);
+            }
+        }
+        return ready;
+    }
+
+    void SceneManager::LoadChunk(SceneChunk& chunk) {
+        entityManagerRef->CreateBatch(std::move(chunk.entities));
+        entityManagerRef->RestoreComponents(chunk.entityIDs, chunk.components);
+        chunk.entities.clear();
+        chunk.loaded = true;
+    }
+
+    void SceneManager::UnloadChunk(SceneChunk& chunk) {
+        // Whatever scripts changed or removed while it was loaded is kept for the next load
+        chunk.entities = entityManagerRef->TakeEntities(chunk.entityIDs, &chunk.components);
+        chunk.loaded = false;
+    }
+
+    std::vector<std::string> SceneManager::GetTags(const CompiledScene& scene, uint32_t tagStart, uint32_t tagCount) {
+        std::vector<std::string> tags;
+        if (tagStart > scene.tagRefs.size() || tagCount > scene.tagRefs.size() - tagStart) {
+            SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene tag range %u+%u is out of bounds", tagStart, tagCount);
+            return tags;
+        }
+        tags.reserve(tagCount);
+        for (uint32_t i = 0; i < tagCount; ++i) {
+            tags.push_back(scene.GetString(scene.tagRefs[tagStart + i]));
+        }
+        return tags;
+    }
+
+    std::vector<Entity> SceneManager::BuildEntities(const CompiledScene& scene) {
+        // Entities are fully built here and inserted under a single lock
+        std::vector<Entity> prepared;
+        prepared.reserve(scene.entities.size());
 
-                UIElement* element = uiManagerRef->GetElementByID(id);
-                if (element) {
-                    element->visible = uiJson.value("visible", true);
-                    element->zIndex = uiJson.value("zIndex", 0);
+        for (const SceneEntityRecord& record : scene.entities) {
+            Entity& entity = prepared.emplace_back();
+            entity.position = Vec2(record.position[0], record.position[1]);
+            entity.rotation = record.rotation;
+            entity.scale = Vec2(record.scale[0], record.scale[1]);
+            entity.flipX = (record.flags & SCENE_ENTITY_FLIP_X) != 0;
+            entity.flipY = (record.flags & SCENE_ENTITY_FLIP_Y) != 0;
+            entity.visible = (record.flags & SCENE_ENTITY_VISIBLE) != 0;
+            entity.physApplied = (record.flags & SCENE_ENTITY_PHYSICS) != 0;
+            entity.mass = record.mass;
+            entity.drag = record.drag;
+            entity.zIndex = record.zIndex;
+            entity.color = RGBA(record.color[0], record.color[1], record.color[2], record.color[3]);
+            entity.tags = GetTags(scene, record.tagStart, record.tagCount);
 
-                    if (uiJson.contains("tags")) {
-                        element->tags = uiJson["tags"].get<std::vector<std::string>>();
+            if (record.flags & SCENE_ENTITY_SPRITELESS) {
+                entity.isSpriteless = true;
+                entity.spritelessWidth = record.spritelessSize[0];
+                entity.spritelessHeight = record.spritelessSize[1];
+                entity.spritelessColor = RGBA(record.spritelessColor[0], record.spritelessColor[1],
+                                              record.spritelessColor[2], record.spritelessColor[3]);
+                entity.collider.size = Vec2(entity.spritelessWidth * entity.scale.x, entity.spritelessHeight * entity.scale.y);
+            } else {
+                if (record.sprite >= scene.sprites.size()) {
+                    SDL_LogError(SDL_LOG_CATEGORY_APPLICATION, "Scene entity references missing sprite %u", record.sprite);
+                    prepared.pop_back();
+                    continue;
+                }
+                const SceneSpriteRecord& sprite = scene.sprites[record.sprite];
+                entity.spritePath = scene.GetString(sprite.path);
+                entity.spriteWidth = sprite.width;
+                entity.spriteHeight = sprite.height;
+
+                if (record.totalFrames > 1 || record.fps > 0.0f) {
+                    if (record.totalFrames <= 0 || record.fps <= 0.0f) {
+                        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Invalid animation for %s: %d frames at %f fps",
+                                     entity.spritePath.c_str(), record.totalFrames, record.fps);
+                        prepared.pop_back();
+                        continue;
                     }
+                    entity.totalFrames = record.totalFrames;
+                    entity.fps = record.fps;
                 }
             }
+
+            entity.collider.type = static_cast<ColliderType>(record.colliderType);
+            entity.collider.enabled = (record.flags & SCENE_ENTITY_COLLIDER_ENABLED) != 0;
+            entity.collider.offset = Vec2(record.colliderOffset[0], record.colliderOffset[1]);
+            if (record.colliderSize[0] != 0.0f || record.colliderSize[1] != 0.0f) {
+                entity.collider.size = Vec2(record.colliderSize[0], record.colliderSize[1]);
+            }
         }
 
-        return true;
+        return prepared;
+    }
+
+    void SceneManager::InstantiateUI(const CompiledScene& scene) {
+        for (const SceneUIRecord& record : scene.ui) {
+            UIElementType type = static_cast<UIElementType>(record.type);
+            
+            if (type == UIElementType::BUTTON) continue;
+
+            uint32_t id;
+            RGBA color(record.color[0], record.color[1], record.color[2], record.color[3]);
+
+            Border border;
+            border.color = RGBA(record.borderColor[0], record.borderColor[1], record.borderColor[2], record.borderColor[3]);
+            border.thickness = record.borderThickness;
+            border.radius = record.borderRadius;
+
+            const std::string& textContent = scene.GetString(record.textContent);
+            const std::string& fontPath = scene.GetString(record.fontPath);
+            RGBA textColor(record.textColor[0], record.textColor[1], record.textColor[2], record.textColor[3]);
+
+            if (type == UIElementType::TEXT) {
+                id = uiManagerRef->AddText(record.x, record.y, record.fontSize, textColor, fontPath, textContent);
+            } else {
+                id = uiManagerRef->AddRect(record.x, record.y, record.width, record.height, color, textContent, border,
+                                           fontPath, record.fontSize, textColor);
+            }
+
+            UIElement* element = uiManagerRef->GetElementByID(id);
+            if (element) {
+                element->visible = (record.flags & SCENE_UI_VISIBLE) != 0;
+                element->zIndex = record.zIndex;
+                element->tags = GetTags(scene, record.tagStart, record.tagCount);
+            }
+        }
     }
 }
@@ -3,7 +3,15 @@
 #include "Renderer/EntityManager.h"
 #include "UI/UIManager.h"
 #include "Physics/Physics.h"
+#include "SceneFormat.h"
+#include "Renderer/TextureLoader.h"
+#include <atomic>
+#include <functional>
 #include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include "Renderer/Renderer.h"
 
@@ -11,8 +19,28 @@ namespace SquareCore {
 
 class SceneManager {
 public:
+    SceneManager() = default;
+    ~SceneManager();
+
     bool SaveScene(const std::string& filepath);
+    // Loads a .square JSON scene, or its cooked .squareb when one exists that is at least as new
     bool LoadScene(const std::string& filepath);
+    // Reads, parses and decodes a scene on a background thread while the current scene keeps running. Update
+    // uploads its sprites a few per frame and then swaps it in, persistent entities and UI survive the swap.
+    // onLoaded runs on the render thread right after the swap (false if the scene failed to load). Starting a
+    // new load cancels one still in progress
+    bool LoadSceneAsync(const std::string& filepath, std::function<void(bool)> onLoaded = nullptr);
+    bool IsLoadingScene() const { return asyncLoad.active; }
+    // Advances an asynchronous load and streams chunks in and out, call on the render thread once per frame
+    void Update(float budgetMs = 2.0f);
+
+    // Splits the static entities (no physics, not persistent) of scenes loaded afterwards into square chunks of
+    // chunkSize centimeters. A chunk is loaded once the camera comes within loadRadius of it and unloaded again
+    // past unloadRadius, its sprites are decoded on a worker thread first. Streamed entities keep their IDs across
+    // reloads but only exist while their chunk is loaded. A chunkSize of 0 disables streaming (the default)
+    void SetStreaming(float chunkSize, float loadRadius, float unloadRadius);
+    size_t GetChunkCount() const { return chunks.size(); }
+    size_t GetLoadedChunkCount() const;
     
     void SetEntityManager(EntityManager* entityManager) {entityManagerRef = entityManager; }
     void SetUIManager(UIManager* uiManager) { uiManagerRef = uiManager; }
@@ -24,6 +52,64 @@ private:
     UIManager* uiManagerRef = nullptr;
     Physics* physicsRef = nullptr;
     Renderer* rendererRef = nullptr;
+
+    // Staging world filled by the loader thread, only touched by the render thread once ready is set
+    struct AsyncSceneLoad {
+        bool active = false;
+        std::string filepath;
+        std::function<void(bool)> onLoaded;
+        std::thread loaderThread;
+        std::atomic<bool> ready{false};
+        std::atomic<bool> cancelled{false};
+
+        bool succeeded = false;
+        CompiledScene scene;
+        std::vector<Entity> entities;
+        // Sprite sheets not yet in the texture cache, decoded off-thread and uploaded by Update
+        std::vector<std::pair<std::string, SDL_Surface*>> surfaces;
+        size_t uploadedSurfaces = 0;
+    };
+    AsyncSceneLoad asyncLoad;
+
+    // Part of a streamed scene, its entities are kept here while it is unloaded
+    struct SceneChunk {
+        Vec2 min;
+        Vec2 max;
+        bool loaded = false;
+        std::vector<Entity> entities;
+        std::vector<uint32_t> entityIDs;
+        std::vector<std::string> spritePaths;
+        // Components scripts added to its entities, parked with them while it is unloaded
+        ComponentRegistry components;
+    };
+    std::vector<SceneChunk> chunks;
+    float chunkSize = 0.0f;
+    float chunkLoadRadius = 0.0f;
+    float chunkUnloadRadius = 0.0f;
+
+    // Sprites of chunks about to load are decoded here and uploaded within the frame budget
+    TextureLoader chunkTextureLoader;
+    std::vector<std::pair<std::string, SDL_Surface*>> decodedChunkTextures;
+    std::unordered_set<std::string> pendingChunkTextures;
+    std::unordered_set<std::string> failedChunkTextures;
+    // Set when chunks unloaded while a scene load was still deciding which cached textures it reuses
+    bool textureReleasePending = false;
+
+    bool ReadScene(const std::string& filepath, CompiledScene& scene);
+    void LoaderThread();
+    void AdvanceAsyncLoad(float budgetMs);
+    void CancelAsyncLoad();
+    // Clears the current scene and instantiates the given one in its place
+    void CommitScene(const CompiledScene& scene, std::vector<Entity>&& entities);
+    static std::vector<Entity> BuildEntities(const CompiledScene& scene);
+    // Moves the streamable entities into chunks, the rest stay in entities
+    void PartitionChunks(std::vector<Entity>& entities);
+    void UpdateStreaming(float budgetMs);
+    bool ChunkTexturesReady(const SceneChunk& chunk);
+    void LoadChunk(SceneChunk& chunk);
+    void UnloadChunk(SceneChunk& chunk);
+    void InstantiateUI(const CompiledScene& scene);
+    static std::vector<std::string> GetTags(const CompiledScene& scene, uint32_t tagStart, uint32_t tagCount);
 };
 
 }
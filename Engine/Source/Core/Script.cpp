@@ -24,6 +24,24 @@ namespace SquareCore
         return 0;
     }
 
+    std::vector<uint32_t> Script::QueryRect(const Vec2& min, const Vec2& max)
+    {
+        if (entityManagerRef) return entityManagerRef->QueryRect(min, max);
+        return {};
+    }
+
+    std::vector<uint32_t> Script::QueryRadius(const Vec2& center, float radius)
+    {
+        if (entityManagerRef) return entityManagerRef->QueryRadius(center, radius);
+        return {};
+    }
+
+    uint32_t Script::Nearest(const std::string& tag, const Vec2& from, float maxDistance)
+    {
+        if (entityManagerRef) return entityManagerRef->Nearest(tag, from, maxDistance);
+        return 0;
+    }
+
     uint32_t Script::AddEntity(const char* spritePath, float Xpos, float Ypos, float rotation,
                                       float Xscale, float Yscale, bool physEnabled, std::vector<std::string> tags)
     {
@@ -57,6 +75,50 @@ namespace SquareCore
         return 0;
     }
 
+    std::vector<uint32_t> Script::CreateEntityBatch(std::span<const Entity> descriptors)
+    {
+        if (entityManagerRef)
+        {
+            return entityManagerRef->CreateBatch(descriptors);
+        }
+        return std::vector<uint32_t>(descriptors.size(), 0);
+    }
+
+    uint32_t Script::RegisterPrefab(const std::string& name, const Entity& base)
+    {
+        if (entityManagerRef)
+        {
+            return entityManagerRef->RegisterPrefab(name, base);
+        }
+        return 0;
+    }
+
+    uint32_t Script::GetPrefabID(const std::string& name)
+    {
+        if (entityManagerRef)
+        {
+            return entityManagerRef->GetPrefabID(name);
+        }
+        return 0;
+    }
+
+    uint32_t Script::InstantiatePrefab(const PrefabInstance& instance)
+    {
+        if (entityManagerRef)
+        {
+            return entityManagerRef->Instantiate(instance);
+        }
+        return 0;
+    }
+
+    uint32_t Script::InstantiatePrefab(uint32_t prefabID, const Vec2& position)
+    {
+        PrefabInstance instance;
+        instance.prefabID = prefabID;
+        instance.position = position;
+        return InstantiatePrefab(instance);
+    }
+
     void Script::RemoveEntity(uint32_t entityID)
     {
         if (entityManagerRef && physicsRef)
@@ -194,6 +256,36 @@ namespace SquareCore
         return 0;
     }
 
+    uint32_t Script::RegisterAnimationClips(const std::string& name, std::vector<AnimationClip> clips)
+    {
+        if (entityManagerRef) return entityManagerRef->RegisterAnimationClips(name, std::move(clips));
+        return 0;
+    }
+
+    uint32_t Script::GetAnimationClipSetID(const std::string& name) const
+    {
+        if (entityManagerRef) return entityManagerRef->GetAnimationClipSetID(name);
+        return 0;
+    }
+
+    bool Script::SetAnimationClips(uint32_t entityID, uint32_t clipSetID)
+    {
+        if (entityManagerRef) return entityManagerRef->SetAnimationClips(entityID, clipSetID);
+        return false;
+    }
+
+    bool Script::PlayAnimation(uint32_t entityID, const std::string& clipName, bool restart)
+    {
+        if (entityManagerRef) return entityManagerRef->PlayAnimation(entityID, clipName, restart);
+        return false;
+    }
+
+    std::vector<AnimationEvent> Script::GetAnimationEvents() const
+    {
+        if (entityManagerRef) return entityManagerRef->GetAnimationEvents();
+        return {};
+    }
+
     bool Script::EntityHasTag(uint32_t entityID, std::string tag)
     {
         if (entityManagerRef) return entityManagerRef->EntityHasTag(entityID, tag);
@@ -210,15 +302,15 @@ namespace SquareCore
         if (entityManagerRef) entityManagerRef->RemoveTagFromEntity(entityID, tag);
     }
 
-    void Script::AddPropertyToEntity(uint32_t entityID, Property* property)
+    uint32_t Script::DeferAddEntity(const Entity& entity)
     {
-        if (entityManagerRef) entityManagerRef->AddPropertyToEntity(entityID, property);
+        if (entityManagerRef) return entityManagerRef->GetCommandBuffer().Spawn(entity);
+        return 0;
     }
 
-    std::vector<Property*> Script::GetAllEntityProperties(uint32_t entityID)
+    void Script::DeferRemoveEntity(uint32_t entityID)
     {
-        if (entityManagerRef) return entityManagerRef->GetAllEntityProperties(entityID);
-        return {};
+        if (entityManagerRef) entityManagerRef->GetCommandBuffer().Remove(entityID);
     }
 
     void Script::SetZIndex(uint32_t entityID, int zIndex)
@@ -431,6 +523,20 @@ namespace SquareCore
         }
     }
 
+    void Script::SetBullet(uint32_t entityID, bool bullet)
+    {
+        if (physicsRef)
+        {
+            physicsRef->SetBullet(entityID, bullet);
+        }
+    }
+
+    bool Script::IsSleeping(uint32_t entityID)
+    {
+        if (physicsRef) return physicsRef->IsSleeping(entityID);
+        return false;
+    }
+
     Vec2 Script::GetVelocity(uint32_t entityID)
     {
         if (entityManagerRef)
@@ -696,6 +802,31 @@ namespace SquareCore
         return {};
     }
 
+    uint64_t Script::GetClientViewTime(uint32_t clientID)
+    {
+        return GetInputForClient(clientID).timestamp;
+    }
+
+    std::vector<uint32_t> Script::OverlapBoxAt(uint64_t timestamp, float centerX, float centerY,
+                                               float halfWidth, float halfHeight, uint32_t ignoreEntityID)
+    {
+        if (physicsRef)
+        {
+            return physicsRef->OverlapBoxAt(timestamp, Vec2(centerX, centerY), Vec2(halfWidth, halfHeight), ignoreEntityID);
+        }
+        return {};
+    }
+
+    Vec2 Script::GetPositionAt(uint32_t entityID, uint64_t timestamp)
+    {
+        Vec2 position = GetPosition(entityID);
+        if (physicsRef)
+        {
+            physicsRef->GetPositionAt(entityID, timestamp, position);
+        }
+        return position;
+    }
+
     std::vector<uint32_t> Script::GetConnectedClients()
     {
         if (serverRef)
@@ -1107,4 +1238,36 @@ namespace SquareCore
         if (!sceneManagerRef) return false;
         return sceneManagerRef->LoadScene(filepath);
     }
+
+    bool Script::LoadSceneAsync(const std::string& filepath, std::function<void(bool)> onLoaded)
+    {
+        if (!sceneManagerRef)
+        {
+            // Nothing will ever finish the load, report the failure now so callers still run their setup
+            if (onLoaded) onLoaded(false);
+            return false;
+        }
+        return sceneManagerRef->LoadSceneAsync(filepath, std::move(onLoaded));
+    }
+
+    bool Script::IsLoadingScene() const
+    {
+        return sceneManagerRef && sceneManagerRef->IsLoadingScene();
+    }
+
+    void Script::SetSceneStreaming(float chunkSize, float loadRadius, float unloadRadius)
+    {
+        if (sceneManagerRef) sceneManagerRef->SetStreaming(chunkSize, loadRadius, unloadRadius);
+    }
+
+    void Script::SaveWorldSnapshot(PhysicsSnapshot& snapshot)
+    {
+        if (physicsRef) physicsRef->SaveSnapshot(snapshot);
+    }
+
+    bool Script::RestoreWorldSnapshot(const PhysicsSnapshot& snapshot)
+    {
+        if (!physicsRef) return false;
+        return physicsRef->RestoreSnapshot(snapshot);
+    }
 }
\ No newline at end of file
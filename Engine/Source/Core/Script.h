@@ -75,9 +75,22 @@ namespace SquareCore
         // Add a spriteless entity to the scene
         uint32_t AddSpritelessEntity(float width, float height, RGBA color, float Xpos = 0.0f, float Ypos = 0.0f,
             float rotation = 0.0f, float Xscale = 1.0f, float Yscale = 1.0f, bool physEnabled = false);
+        // Add many fully specified entities at once, returns their IDs in order (0 where one couldn't be created)
+        std::vector<uint32_t> CreateEntityBatch(std::span<const Entity> descriptors);
+        // Register a shared template for entities spawned many times, returns its ID (0 on failure)
+        uint32_t RegisterPrefab(const std::string& name, const Entity& base);
+        uint32_t GetPrefabID(const std::string& name);
+        // Add an entity from a prefab, only the instance's overrides are applied on top of it
+        uint32_t InstantiatePrefab(const PrefabInstance& instance);
+        uint32_t InstantiatePrefab(uint32_t prefabID, const Vec2& position);
         
         std::vector<uint32_t> GetAllEntitiesWithTag(std::string tag);
         uint32_t GetFirstEntityWithTag(std::string tag);
+        // Entities whose bounds overlap a rectangle or circle, answered from the spatial index
+        std::vector<uint32_t> QueryRect(const Vec2& min, const Vec2& max);
+        std::vector<uint32_t> QueryRadius(const Vec2& center, float radius);
+        // Closest entity with the tag, 0 if none is within maxDistance
+        uint32_t Nearest(const std::string& tag, const Vec2& from, float maxDistance = FLT_MAX);
         
         // Removes an entity from the screen
         void RemoveEntity(uint32_t entityID);
@@ -113,13 +126,51 @@ namespace SquareCore
         void SetAnimationFrame(uint32_t entityID, int frame);
         bool IsAnimationComplete(uint32_t entityID) const;
         int GetTotalFrames(uint32_t entityID) const;
+        // Named clips within one sprite sheet, see EntityManager::RegisterAnimationClips
+        uint32_t RegisterAnimationClips(const std::string& name, std::vector<AnimationClip> clips);
+        uint32_t GetAnimationClipSetID(const std::string& name) const;
+        bool SetAnimationClips(uint32_t entityID, uint32_t clipSetID);
+        bool PlayAnimation(uint32_t entityID, const std::string& clipName, bool restart = false);
+        // Clips that finished or looped this frame
+        std::vector<AnimationEvent> GetAnimationEvents() const;
 
         bool EntityHasTag(uint32_t entityID, std::string tag);
         void AddTagToEntity(uint32_t entityID, std::string tag);
         void RemoveTagFromEntity(uint32_t entityID, std::string tag);
         
-        void AddPropertyToEntity(uint32_t entityID, Property* property);
-        std::vector<Property*> GetAllEntityProperties(uint32_t entityID);
+        // Typed per-entity state, see EntityManager::AddComponent. Don't keep the returned pointers across frames
+        template<typename T, typename... Args>
+        T* AddComponent(uint32_t entityID, Args&&... args)
+        {
+            return entityManagerRef ? entityManagerRef->AddComponent<T>(entityID, std::forward<Args>(args)...) : nullptr;
+        }
+        template<typename T>
+        T* GetComponent(uint32_t entityID) { return entityManagerRef ? entityManagerRef->GetComponent<T>(entityID) : nullptr; }
+        template<typename T>
+        bool HasComponent(uint32_t entityID) { return GetComponent<T>(entityID) != nullptr; }
+        template<typename T>
+        void RemoveComponent(uint32_t entityID) { if (entityManagerRef) entityManagerRef->RemoveComponent<T>(entityID); }
+        // Calls func(entityID, T&...) for every entity with all of the given components
+        template<typename... T, typename Func>
+        void View(Func&& func) { if (entityManagerRef) entityManagerRef->View<T...>(std::forward<Func>(func)); }
+        // Locks the entities once for a block of reads and writes, see EntityBatch. Keep the batch short and don't
+        // call other entity functions while it's alive
+        EntityBatch BatchEntities() { return EntityBatch(entityManagerRef); }
+
+        // Deferred structural changes, applied together after every script has updated this frame. Safe to call
+        // while iterating entities or components
+        uint32_t DeferAddEntity(const Entity& entity);
+        void DeferRemoveEntity(uint32_t entityID);
+        template<typename T, typename... Args>
+        void DeferAddComponent(uint32_t entityID, Args&&... args)
+        {
+            if (entityManagerRef) entityManagerRef->GetCommandBuffer().AddComponent<T>(entityID, std::forward<Args>(args)...);
+        }
+        template<typename T>
+        void DeferRemoveComponent(uint32_t entityID)
+        {
+            if (entityManagerRef) entityManagerRef->GetCommandBuffer().RemoveComponent<T>(entityID);
+        }
 
         void SetZIndex(uint32_t entityID, int zIndex);
         int GetZIndex(uint32_t entityID);
@@ -157,6 +208,10 @@ namespace SquareCore
         void SetDrag(uint32_t entityID, float drag);
         void SetGravityScale(uint32_t entityID, float gravityScale);
         void SetFixedRotation(uint32_t entityID, bool fixed);
+        // Marks an entity as a fast mover so it can't tunnel through thin colliders
+        void SetBullet(uint32_t entityID, bool bullet);
+        // Returns true while an entity's physics body is at rest
+        bool IsSleeping(uint32_t entityID);
         // Gets an entity's velocity
         Vec2 GetVelocity(uint32_t entityID);
         // Sets an entity's position
@@ -239,6 +294,14 @@ namespace SquareCore
 
         // Gets the input state of a connected client
         InputState GetInputForClient(uint32_t clientID);
+        // Gets the server time of the world a client was seeing when it sent its latest input
+        uint64_t GetClientViewTime(uint32_t clientID);
+        // Gets the entities that overlapped a box at a past server time (eg. a client's view time),
+        // rewinds at most a quarter second and only on the server
+        std::vector<uint32_t> OverlapBoxAt(uint64_t timestamp, float centerX, float centerY,
+                                           float halfWidth, float halfHeight, uint32_t ignoreEntityID = 0);
+        // Gets an entity's position at a past server time
+        Vec2 GetPositionAt(uint32_t entityID, uint64_t timestamp);
         // Gets the IDs of all connected clients
         std::vector<uint32_t> GetConnectedClients();
         // Gets the entity id of a connected client
@@ -312,6 +375,16 @@ namespace SquareCore
         
         bool SaveScene(const std::string& filepath);
         bool LoadScene(const std::string& filepath);
+        // Loads a scene in the background and swaps it in at a later frame, onLoaded runs right after the swap
+        bool LoadSceneAsync(const std::string& filepath, std::function<void(bool)> onLoaded = nullptr);
+        bool IsLoadingScene() const;
+        // Streams the static part of scenes loaded afterwards in chunks around the camera, chunkSize 0 turns it off
+        void SetSceneStreaming(float chunkSize, float loadRadius, float unloadRadius);
+        
+        // Captures the current physics and entity runtime state for a later reset or rollback
+        void SaveWorldSnapshot(PhysicsSnapshot& snapshot);
+        // Restores a captured snapshot in place without reloading the scene
+        bool RestoreWorldSnapshot(const PhysicsSnapshot& snapshot);
 
     private:
         // Internal renderer reference (internal use only)
@@ -3,12 +3,12 @@
 #include <iostream>
 #include <sstream>
 #include <chrono>
+#include <iterator>
 
 namespace SquareCore {
 
-// Global ZMQ context and socket
+// Global ZMQ context
 static zmq::context_t context(1);
-static zmq::socket_t* clientSocket = nullptr;
 
 Client::Client() {
     lastUpdate = std::chrono::steady_clock::now();
@@ -138,12 +138,18 @@ void Client::SendInput(const std::unordered_map<std::string, bool>& buttons,
         return;
     }
 
+    // Stamp the input with what the player was looking at so the server can rewind hit checks to it
+    uint64_t viewTimestamp;
+    {
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        viewTimestamp = latestState.timestamp;
+    }
+
     std::lock_guard<std::mutex> lock(inputMutex);
     pendingInput.clientID = clientId.load();
     pendingInput.buttons = buttons;
     pendingInput.axes = axes;
-    pendingInput.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-        std::chrono::steady_clock::now().time_since_epoch()).count();
+    pendingInput.timestamp = viewTimestamp;
 }
 
 GameStateSnapshot Client::GetLatestGameState() {
@@ -207,59 +213,54 @@ void Client::SendInputAndReceiveState() {
             std::lock_guard<std::mutex> inputLock(inputMutex);
             inputToSend = pendingInput;
         }
+        inputToSend.roundTripMs = stats.roundTripMs.load(std::memory_order_relaxed);
 
         // Send input to server
         std::string inputMsg = CreateMessage(MessageType::INPUT, inputToSend.Serialize());
         zmq::message_t request(inputMsg.size());
         memcpy(request.data(), inputMsg.data(), inputMsg.size());
 
+        auto sendTime = std::chrono::steady_clock::now();
         if (clientSocket->send(request, zmq::send_flags::none)) {
+            stats.Add(stats.bytesSent, inputMsg.size());
+            stats.Add(stats.messagesSent);
+
             // Receive game state response
             zmq::message_t reply;
             auto result = clientSocket->recv(reply, zmq::recv_flags::none);
 
+            // Queued messages and the shared game state may arrive as separate frames
+            ClientReplyInfo info;
+            while (result) {
+                info.replyBytes += reply.size();
+                info.stateBytes += ProcessServerMessages(std::string(static_cast<char*>(reply.data()), reply.size()));
+                if (!reply.more()) break;
+                result = clientSocket->recv(reply, zmq::recv_flags::none);
+            }
+
             if (result) {
-                std::string response(static_cast<char*>(reply.data()), reply.size());
-
-                // Server sends multiple messages separated by newlines
-                std::istringstream responseStream(response);
-                std::string line;
-
-                while (std::getline(responseStream, line)) {
-                    if (line.empty()) continue;
-
-                    MessageType msgType;
-                    std::string payload;
-                    if (ParseMessage(line, msgType, payload)) {
-                        if (msgType == MessageType::SPAWN_ENTITY) {
-                            // Parse and queue entity spawn
-                            EntitySpawnInfo spawnInfo = EntitySpawnInfo::Deserialize(payload);
-                            {
-                                std::lock_guard<std::mutex> msgLock(pendingMessagesMutex);
-                                pendingSpawns.push_back(spawnInfo);
-                            }
-                        }
-                        else if (msgType == MessageType::DESPAWN_ENTITY) {
-                            // Parse and queue entity despawn
-                            uint32_t entityID = std::stoul(payload);
-                            {
-                                std::lock_guard<std::mutex> msgLock(pendingMessagesMutex);
-                                pendingDespawns.push_back(entityID);
-                            }
-                        }
-                        else if (msgType == MessageType::GAME_STATE) {
-                            // Parse game state
-                            GameStateSnapshot newState = GameStateSnapshot::Deserialize(payload);
-
-                            // Update latest state
-                            {
-                                std::lock_guard<std::mutex> stateLock(stateMutex);
-                                latestState = newState;
-                            }
-                        }
-                    }
+                info.roundTripMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - sendTime).count();
+                if (info.stateBytes > 0) {
+                    std::lock_guard<std::mutex> stateLock(stateMutex);
+                    info.stateTimestamp = latestState.timestamp;
+                }
+
+                stats.Add(stats.bytesReceived, info.replyBytes);
+                stats.Add(stats.messagesReceived);
+                stats.AddRoundTrip(static_cast<float>(info.roundTripMs));
+                if (info.stateBytes > 0 && info.stateTimestamp != lastStateTimestamp) {
+                    stats.Add(stats.snapshotsSent);
+                    lastStateTimestamp = info.stateTimestamp;
                 }
+
+                if (replyObserver) {
+                    replyObserver(info);
+                }
+            } else {
+                stats.Add(stats.failedExchanges);
             }
+        } else {
+            stats.Add(stats.failedExchanges);
         }
 
     } catch (const zmq::error_t& e) {
@@ -271,4 +272,61 @@ void Client::SendInputAndReceiveState() {
     }
 }
 
+size_t Client::ProcessServerMessages(const std::string& response) {
+    // Game state frames carry a binary payload, so they are never split into lines
+    std::string gameStatePrefix = std::to_string(static_cast<int>(MessageType::GAME_STATE)) + " ";
+    if (response.compare(0, gameStatePrefix.size(), gameStatePrefix) == 0) {
+        GameStateSnapshot newState = GameStateSnapshot::Deserialize(response.substr(gameStatePrefix.size()));
+
+        std::lock_guard<std::mutex> stateLock(stateMutex);
+        latestState = std::move(newState);
+        return response.size();
+    }
+
+    // World state chunks are binary too, their spawns join the pending queue in order
+    std::string worldChunkPrefix = std::to_string(static_cast<int>(MessageType::WORLD_STATE_CHUNK)) + " ";
+    if (response.compare(0, worldChunkPrefix.size(), worldChunkPrefix) == 0) {
+        WorldStateChunk chunk = WorldStateChunk::Deserialize(response.substr(worldChunkPrefix.size()));
+
+        std::lock_guard<std::mutex> msgLock(pendingMessagesMutex);
+        pendingSpawns.insert(pendingSpawns.end(), std::make_move_iterator(chunk.spawns.begin()),
+                             std::make_move_iterator(chunk.spawns.end()));
+        if (chunk.chunkIndex + 1 == chunk.chunkCount) {
+            std::cout << "Received world state (" << chunk.chunkCount << " chunks)\n";
+        }
+        return 0;
+    }
+
+    // Server sends multiple messages separated by newlines
+    std::istringstream responseStream(response);
+    std::string line;
+
+    while (std::getline(responseStream, line)) {
+        if (line.empty()) continue;
+
+        MessageType msgType;
+        std::string payload;
+        if (ParseMessage(line, msgType, payload)) {
+            if (msgType == MessageType::SPAWN_ENTITY) {
+                // Parse and queue entity spawn
+                EntitySpawnInfo spawnInfo = EntitySpawnInfo::Deserialize(payload);
+                {
+                    std::lock_guard<std::mutex> msgLock(pendingMessagesMutex);
+                    pendingSpawns.push_back(spawnInfo);
+                }
+            }
+            else if (msgType == MessageType::DESPAWN_ENTITY) {
+                // Parse and queue entity despawn
+                uint32_t entityID = std::stoul(payload);
+                {
+                    std::lock_guard<std::mutex> msgLock(pendingMessagesMutex);
+                    pendingDespawns.push_back(entityID);
+                }
+            }
+        }
+    }
+
+    return 0;
+}
+
 }
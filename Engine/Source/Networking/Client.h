@@ -2,14 +2,28 @@
 #define CLIENT_H
 
 #include "NetworkProtocol.h"
+#include "NetworkStats.h"
 #include <string>
 #include <unordered_map>
 #include <chrono>
 #include <mutex>
 #include <atomic>
+#include <functional>
+
+namespace zmq {
+class socket_t;
+}
 
 namespace SquareCore {
 
+// Timing and size of one request/reply exchange with the server
+struct ClientReplyInfo {
+    double roundTripMs = 0.0;
+    size_t replyBytes = 0;      // All frames, including queued spawn/despawn messages
+    size_t stateBytes = 0;      // Game state frame only, 0 if the reply had none
+    uint64_t stateTimestamp = 0;
+};
+
 class Client {
 public:
     Client();
@@ -39,6 +53,12 @@ public:
     // Get this client's ID
     uint32_t GetClientId() const { return clientId.load(); }
 
+    // Get telemetry counters for this connection (thread-safe)
+    ConnectionStatsSample GetStats() const { return stats.Sample(clientId.load()); }
+
+    // Called on the thread running Update after every reply from the server
+    void SetReplyObserver(std::function<void(const ClientReplyInfo&)> observer) { replyObserver = std::move(observer); }
+
 private:
     // Thread-safe connection state
     std::atomic<bool> connected{false};
@@ -58,15 +78,25 @@ private:
     std::vector<uint32_t> pendingDespawns;
     mutable std::mutex pendingMessagesMutex;
 
+    // Socket to the server, owned by this client so several can run in one process
+    zmq::socket_t* clientSocket = nullptr;
     // Mutex for socket synchronization
     mutable std::mutex socketMutex;
 
+    std::function<void(const ClientReplyInfo&)> replyObserver;
+
+    // Telemetry, updated on the send/recv path
+    ConnectionStats stats;
+    uint64_t lastStateTimestamp = 0;
+
     // Connection timing
     std::chrono::time_point<std::chrono::steady_clock> lastUpdate;
     static constexpr int UPDATE_INTERVAL_MS = 16;
 
     // Send input and receive game state
     void SendInputAndReceiveState();
+    // Parse newline separated messages from one reply frame (returns game state bytes parsed)
+    size_t ProcessServerMessages(const std::string& response);
 
     // Socket management
     void InitializeSockets(const std::string& serverAddress);
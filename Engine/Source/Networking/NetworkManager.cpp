@@ -1,5 +1,8 @@
 #include "NetworkManager.h"
 #include <iostream>
+#include <chrono>
+#include <algorithm>
+#include <charconv>
 
 namespace SquareCore {
 
@@ -21,9 +24,11 @@ bool NetworkManager::Connect(const std::string& serverAddress) {
 
 void NetworkManager::Disconnect() {
     client.Disconnect();
+    StopReplay();
     serverToLocalEntityMap.clear();
     localToServerEntityMap.clear();
     entitySpriteInfo.clear();
+    spawnBacklog.clear();
 }
 
 void NetworkManager::Update() {
@@ -31,15 +36,23 @@ void NetworkManager::Update() {
         return;
     }
 
-    // Update client networking
-    client.Update();
+    std::vector<EntitySpawnInfo> spawns;
+    std::vector<uint32_t> despawns;
+    if (replaying) {
+        AdvanceReplay(spawns, despawns);
+    } else {
+        // Update client networking
+        client.Update();
+        spawns = client.GetPendingSpawns();
+        despawns = client.GetPendingDespawns();
+    }
 
     // Process entity spawn/despawn messages
-    ProcessPendingSpawns();
-    ProcessPendingDespawns();
+    ProcessPendingSpawns(std::move(spawns));
+    ProcessPendingDespawns(despawns);
 
     // Get latest game state from server
-    GameStateSnapshot snapshot = client.GetLatestGameState();
+    const GameStateSnapshot& snapshot = replaying ? replayState : client.GetLatestGameState();
 
     // Synchronize local entities with server state
     if (!snapshot.entities.empty()) {
@@ -48,7 +61,83 @@ void NetworkManager::Update() {
 }
 
 bool NetworkManager::IsConnected() const {
-    return client.IsConnected();
+    return replaying || client.IsConnected();
+}
+
+bool NetworkManager::StartReplay(const std::string& path, uint32_t viewAsClientID) {
+    if (client.IsConnected()) {
+        std::cout << "NetworkManager: Disconnect before starting a replay\n";
+        return false;
+    }
+    StopReplay();
+    if (!replay.Open(path)) {
+        return false;
+    }
+
+    replaying = true;
+    replayClientId = viewAsClientID;
+    replayStartTime = std::chrono::steady_clock::now();
+    hasNextReplayRecord = replay.ReadNext(nextReplayRecord);
+    std::cout << "NetworkManager: Replaying " << path << "\n";
+    return true;
+}
+
+void NetworkManager::StopReplay() {
+    if (!replaying) {
+        return;
+    }
+    replay.Close();
+    replaying = false;
+    hasNextReplayRecord = false;
+    replayState = GameStateSnapshot();
+    serverToLocalEntityMap.clear();
+    localToServerEntityMap.clear();
+    spawnBacklog.clear();
+}
+
+void NetworkManager::AdvanceReplay(std::vector<EntitySpawnInfo>& spawns, std::vector<uint32_t>& despawns) {
+    uint64_t elapsedMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - replayStartTime).count();
+
+    while (hasNextReplayRecord && nextReplayRecord.timeMs <= elapsedMs) {
+        const SessionRecord& record = nextReplayRecord;
+        switch (record.type) {
+        case SessionRecordType::WORLD_STATE_CHUNK: {
+            WorldStateChunk chunk = WorldStateChunk::Deserialize(record.payload);
+            spawns.insert(spawns.end(), std::make_move_iterator(chunk.spawns.begin()),
+                          std::make_move_iterator(chunk.spawns.end()));
+            break;
+        }
+        case SessionRecordType::SPAWN:
+            spawns.push_back(EntitySpawnInfo::Deserialize(record.payload));
+            break;
+        case SessionRecordType::DESPAWN: {
+            // A corrupt or truncated record is skipped rather than ending the replay
+            uint32_t entityID = 0;
+            const char* end = record.payload.data() + record.payload.size();
+            std::from_chars_result result = std::from_chars(record.payload.data(), end, entityID);
+            if (result.ec == std::errc() && result.ptr == end) {
+                despawns.push_back(entityID);
+            } else {
+                std::cout << "NetworkManager: Skipping malformed despawn record at " << record.timeMs << " ms\n";
+            }
+            break;
+        }
+        case SessionRecordType::GAME_STATE:
+            // Snapshots are complete, so only the newest one due this frame matters
+            replayState = GameStateSnapshot::Deserialize(record.payload);
+            break;
+        case SessionRecordType::INPUT:
+            // Inputs are kept for offline analysis, the recorded snapshots already reflect them
+            break;
+        }
+
+        hasNextReplayRecord = replay.ReadNext(nextReplayRecord);
+        if (!hasNextReplayRecord) {
+            std::cout << "NetworkManager: Replay finished after " << elapsedMs << " ms\n";
+            replay.Close();
+        }
+    }
 }
 
 void NetworkManager::SendInput(const std::unordered_map<std::string, bool>& buttons,
@@ -59,57 +148,68 @@ void NetworkManager::SendInput(const std::unordered_map<std::string, bool>& butt
 }
 
 uint32_t NetworkManager::GetClientId() const {
-    return client.GetClientId();
+    return replaying ? replayClientId : client.GetClientId();
 }
 
-void NetworkManager::ProcessPendingSpawns() {
+void NetworkManager::ProcessPendingSpawns(std::vector<EntitySpawnInfo> spawns) {
     if (!entityManagerRef) {
         return;
     }
 
-    // Get spawn messages from client
-    std::vector<EntitySpawnInfo> spawns = client.GetPendingSpawns();
+    spawnBacklog.insert(spawnBacklog.end(), std::make_move_iterator(spawns.begin()), std::make_move_iterator(spawns.end()));
 
-    for (const EntitySpawnInfo& spawnInfo : spawns) {
-        // Check if we've already spawned this server entity ID
-        if (serverToLocalEntityMap.count(spawnInfo.entityID) > 0) {
-            continue;  // Already spawned
+    // A large world state is applied over several frames instead of stalling one, in batches that each take the
+    // entity lock once
+    auto start = std::chrono::steady_clock::now();
+    size_t spawnedThisFrame = 0;
+    std::vector<EntitySpawnInfo> batch;
+    std::vector<Entity> descriptors;
+    std::unordered_set<uint32_t> batchServerIDs;
+
+    while (!spawnBacklog.empty()) {
+        if (spawnedThisFrame > 0 &&
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= SPAWN_BUDGET_MS) {
+            break;
         }
 
-        // Create entity based on whether it's animated or not
-        uint32_t localEntityID = 0;
-        if (spawnInfo.totalFrames > 1) {
-            // Animated entity
-            localEntityID = entityManagerRef->AddAnimatedEntity(
-                spawnInfo.spritePath.c_str(),
-                spawnInfo.totalFrames,
-                spawnInfo.fps,
-                spawnInfo.position.x,
-                spawnInfo.position.y,
-                spawnInfo.rotation,
-                spawnInfo.scale.x,
-                spawnInfo.scale.y,
-                spawnInfo.physEnabled
-            );
-        } else {
-            // Static entity
-            localEntityID = entityManagerRef->AddEntity(
-                spawnInfo.spritePath.c_str(),
-                spawnInfo.position.x,
-                spawnInfo.position.y,
-                spawnInfo.rotation,
-                spawnInfo.scale.x,
-                spawnInfo.scale.y,
-                spawnInfo.physEnabled
-            );
+        batch.clear();
+        descriptors.clear();
+        batchServerIDs.clear();
+        while (!spawnBacklog.empty() && batch.size() < SPAWN_BATCH_SIZE) {
+            EntitySpawnInfo spawnInfo = std::move(spawnBacklog.front());
+            spawnBacklog.pop_front();
+
+            // Check if we've already spawned this server entity ID
+            if (serverToLocalEntityMap.count(spawnInfo.entityID) > 0 || !batchServerIDs.insert(spawnInfo.entityID).second) {
+                continue;  // Already spawned
+            }
+
+            Entity& descriptor = descriptors.emplace_back();
+            descriptor.spritePath = spawnInfo.spritePath;
+            descriptor.totalFrames = spawnInfo.totalFrames;
+            descriptor.fps = spawnInfo.totalFrames > 1 ? spawnInfo.fps : 0.0f;
+            descriptor.position = spawnInfo.position;
+            descriptor.rotation = spawnInfo.rotation;
+            descriptor.scale = spawnInfo.scale;
+            descriptor.physApplied = spawnInfo.physEnabled;
+            descriptor.collider.type = static_cast<ColliderType>(spawnInfo.colliderType);
+            batch.push_back(std::move(spawnInfo));
         }
+        spawnedThisFrame += batch.size();
+
+        // Sprites decode in the background, the entities exist right away and show up once their texture is ready
+        std::vector<uint32_t> localEntityIDs = entityManagerRef->CreateBatch(std::move(descriptors), true);
 
-        // Map server ID to local ID
-        if (localEntityID != 0) {
+        for (size_t i = 0; i < batch.size(); ++i) {
+            const EntitySpawnInfo& spawnInfo = batch[i];
+            uint32_t localEntityID = localEntityIDs[i];
+            if (localEntityID == 0) {
+                continue;
+            }
+
+            // Map server ID to local ID
             serverToLocalEntityMap[spawnInfo.entityID] = localEntityID;
             localToServerEntityMap[localEntityID] = spawnInfo.entityID;
-
-            entityManagerRef->SetColliderType(localEntityID, static_cast<ColliderType>(spawnInfo.colliderType));
             spawnedEntities.insert(localEntityID);
 
             // Check if this entity is owned by us
@@ -118,32 +218,35 @@ void NetworkManager::ProcessPendingSpawns() {
                 std::cout << "NetworkManager: This is our player entity! Local ID: " << localEntityID
                           << " (Server ID: " << spawnInfo.entityID << ")\n";
             }
-
-            std::cout << "NetworkManager: Spawned entity - Server ID: " << spawnInfo.entityID
-                      << " -> Local ID: " << localEntityID
-                      << " (" << spawnInfo.spritePath << ")\n";
         }
     }
+
+    if (spawnedThisFrame > 0) {
+        std::cout << "NetworkManager: Spawned " << spawnedThisFrame << " entities ("
+                  << spawnBacklog.size() << " still pending)\n";
+    }
 }
 
-void NetworkManager::ProcessPendingDespawns() {
+void NetworkManager::ProcessPendingDespawns(const std::vector<uint32_t>& despawns) {
     if (!entityManagerRef) {
         return;
     }
 
-    // Get despawn messages from client
-    std::vector<uint32_t> despawns = client.GetPendingDespawns();
-
+    std::vector<uint32_t> localDespawns;
     for (uint32_t serverEntityID : despawns) {
         // Translate server entity ID to local entity ID
         if (serverToLocalEntityMap.count(serverEntityID) == 0) {
-            continue;  // Not found in mapping
+            // Not spawned yet, make sure it never will be
+            spawnBacklog.erase(std::remove_if(spawnBacklog.begin(), spawnBacklog.end(),
+                [serverEntityID](const EntitySpawnInfo& spawn) { return spawn.entityID == serverEntityID; }),
+                spawnBacklog.end());
+            continue;
         }
 
         uint32_t localEntityID = serverToLocalEntityMap[serverEntityID];
 
         if (spawnedEntities.count(localEntityID) > 0) {
-            entityManagerRef->RemoveEntity(localEntityID);
+            localDespawns.push_back(localEntityID);
             spawnedEntities.erase(localEntityID);
 
             // Clean up mappings
@@ -154,6 +257,9 @@ void NetworkManager::ProcessPendingDespawns() {
                       << " (was Local ID: " << localEntityID << ")\n";
         }
     }
+
+    // Remove the whole tick's despawns in one pass
+    entityManagerRef->RemoveEntities(localDespawns);
 }
 
 void NetworkManager::SyncEntitiesFromServer(const GameStateSnapshot& snapshot) {
@@ -177,11 +283,14 @@ void NetworkManager::SyncEntitiesFromServer(const GameStateSnapshot& snapshot) {
             // Update entity transform from server
             entity->position = entitySnap.position;
             entity->velocity = entitySnap.velocity;
-            entity->scale = entitySnap.scale;
+            if (entitySnap.hasScale) {
+                entity->scale = entitySnap.scale;
+            }
             entity->rotation = entitySnap.rotation;
             entity->flipX = entitySnap.flipX;
             entity->flipY = entitySnap.flipY;
             entity->currentFrame = entitySnap.currentFrame;
+            entityManagerRef->UpdateSpatial(localEntityID);
         }
     }
 }
@@ -3,10 +3,13 @@
 
 #include "Client.h"
 #include "NetworkProtocol.h"
+#include "SessionRecording.h"
 #include "Renderer/EntityManager.h"
 #include <unordered_map>
 #include <unordered_set>
 #include <string>
+#include <deque>
+#include <chrono>
 
 namespace SquareCore {
 
@@ -21,9 +24,15 @@ public:
     void Disconnect();
     // Updates the local client
     void Update();
-    // Returns if the local client is connected to a server
+    // Returns if the local client is connected to a server (or playing back a recorded session)
     bool IsConnected() const;
 
+    // Plays a recorded server session back as if it came from a server, at its original pace.
+    // The player entity owned by viewAsClientID becomes the local player
+    bool StartReplay(const std::string& path, uint32_t viewAsClientID = 0);
+    void StopReplay();
+    bool IsReplaying() const { return replaying; }
+
     // Set EntityManager reference for entity manipulation
     void SetEntityManager(EntityManager* entityManager) { entityManagerRef = entityManager; }
 
@@ -54,12 +63,28 @@ private:
     // Track entities spawned by network
     std::unordered_set<uint32_t> spawnedEntities;
 
+    // Spawns received but not applied yet, drained a time slice per frame
+    std::deque<EntitySpawnInfo> spawnBacklog;
+    static constexpr float SPAWN_BUDGET_MS = 4.0f;
+    static constexpr size_t SPAWN_BATCH_SIZE = 256;
+
+    // Session replay, records are read ahead by one so they can be held until they are due
+    SessionReplay replay;
+    bool replaying = false;
+    uint32_t replayClientId = 0;
+    std::chrono::steady_clock::time_point replayStartTime;
+    SessionRecord nextReplayRecord;
+    bool hasNextReplayRecord = false;
+    GameStateSnapshot replayState;
+
     // Synchronize entities from server state
     void SyncEntitiesFromServer(const GameStateSnapshot& snapshot);
 
-    // Process pending spawn/despawn messages from server
-    void ProcessPendingSpawns();
-    void ProcessPendingDespawns();
+    // Process spawn/despawn messages from the server or a replay
+    void ProcessPendingSpawns(std::vector<EntitySpawnInfo> spawns);
+    void ProcessPendingDespawns(const std::vector<uint32_t>& despawns);
+    // Collect the recorded messages that are due by now
+    void AdvanceReplay(std::vector<EntitySpawnInfo>& spawns, std::vector<uint32_t>& despawns);
 
     // Sprite sheet cache
     struct SpriteInfo {
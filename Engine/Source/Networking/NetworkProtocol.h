@@ -7,6 +7,9 @@
 #include <string>
 #include <sstream>
 #include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
 
 namespace SquareCore {
 
@@ -15,7 +18,8 @@ struct InputState {
     uint32_t clientID = 0;
     std::unordered_map<std::string, bool> buttons;
     std::unordered_map<std::string, float> axes;
-    uint64_t timestamp = 0;
+    uint64_t timestamp = 0;    // Server timestamp of the newest snapshot the client had when sampling this input
+    float roundTripMs = 0.0f;  // Sender's smoothed round-trip time, reported for server telemetry
 
     // Serialization
     std::string Serialize() const {
@@ -30,6 +34,8 @@ struct InputState {
             oss << " " << key << " " << value;
         }
 
+        oss << " " << roundTripMs;
+
         return oss.str();
     }
 
@@ -54,10 +60,152 @@ struct InputState {
             input.axes[key] = value;
         }
 
+        // Optional, older clients don't report it
+        if (!(iss >> input.roundTripMs)) {
+            input.roundTripMs = 0.0f;
+        }
+
         return input;
     }
 };
 
+// Bit budgets used to quantize an entity's snapshot, configured per entity class through EntitySpawnInfo
+struct QuantizationProfile {
+    float positionResolution = 1.0f / 16.0f;  // Centimeters per step inside the world bounds
+    int rotationBits = 14;                     // 12-16 bits over a full turn
+    int velocityBits = 14;                     // Bits per axis over [-maxVelocity, maxVelocity]
+    float maxVelocity = 8192.0f;               // Velocity clamp in cm/s
+
+    bool operator==(const QuantizationProfile& other) const {
+        return positionResolution == other.positionResolution && rotationBits == other.rotationBits &&
+               velocityBits == other.velocityBits && maxVelocity == other.maxVelocity;
+    }
+};
+
+// Packs values of arbitrary bit width into a byte string
+class BitWriter {
+public:
+    void Write(uint32_t value, int bits) {
+        uint64_t mask = (bits >= 32) ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+        scratch |= (static_cast<uint64_t>(value) & mask) << scratchBits;
+        scratchBits += bits;
+        while (scratchBits >= 8) {
+            bytes.push_back(static_cast<char>(scratch & 0xFF));
+            scratch >>= 8;
+            scratchBits -= 8;
+        }
+    }
+
+    void WriteBool(bool value) { Write(value ? 1 : 0, 1); }
+
+    void WriteFloat(float value) {
+        uint32_t bitsValue;
+        std::memcpy(&bitsValue, &value, sizeof(bitsValue));
+        Write(bitsValue, 32);
+    }
+
+    // Strings are written as a 16-bit length followed by their bytes
+    void WriteString(const std::string& value) {
+        size_t length = std::min<size_t>(value.size(), 0xFFFF);
+        Write(static_cast<uint32_t>(length), 16);
+        for (size_t i = 0; i < length; ++i) {
+            Write(static_cast<uint8_t>(value[i]), 8);
+        }
+    }
+
+    // Returns the packed bytes, padding the last partial byte with zeros
+    std::string& Finish() {
+        if (scratchBits > 0) {
+            bytes.push_back(static_cast<char>(scratch & 0xFF));
+            scratch = 0;
+            scratchBits = 0;
+        }
+        return bytes;
+    }
+
+private:
+    std::string bytes;
+    uint64_t scratch = 0;
+    int scratchBits = 0;
+};
+
+// Reads values written by BitWriter, reading past the end yields zeros and sets the overflow flag
+class BitReader {
+public:
+    explicit BitReader(const std::string& data) : data(data) {}
+
+    uint32_t Read(int bits) {
+        while (scratchBits < bits) {
+            uint64_t byte = 0;
+            if (position < data.size()) {
+                byte = static_cast<uint8_t>(data[position++]);
+            } else {
+                overflow = true;
+            }
+            scratch |= byte << scratchBits;
+            scratchBits += 8;
+        }
+        uint64_t mask = (bits >= 32) ? 0xFFFFFFFFull : ((1ull << bits) - 1);
+        uint32_t value = static_cast<uint32_t>(scratch & mask);
+        scratch >>= bits;
+        scratchBits -= bits;
+        return value;
+    }
+
+    bool ReadBool() { return Read(1) != 0; }
+
+    float ReadFloat() {
+        uint32_t bitsValue = Read(32);
+        float value;
+        std::memcpy(&value, &bitsValue, sizeof(value));
+        return value;
+    }
+
+    std::string ReadString() {
+        uint32_t length = Read(16);
+        std::string value;
+        value.reserve(length);
+        for (uint32_t i = 0; i < length && !overflow; ++i) {
+            value.push_back(static_cast<char>(Read(8)));
+        }
+        return value;
+    }
+
+    bool HasOverflowed() const { return overflow; }
+
+private:
+    const std::string& data;
+    size_t position = 0;
+    uint64_t scratch = 0;
+    int scratchBits = 0;
+    bool overflow = false;
+};
+
+// Maps a value in [min, max] onto an unsigned integer of the given bit width
+inline uint32_t QuantizeFloat(float value, float min, float max, int bits) {
+    uint32_t steps = (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1);
+    if (max <= min) return 0;
+    double t = (static_cast<double>(value) - min) / (static_cast<double>(max) - min);
+    t = t < 0.0 ? 0.0 : (t > 1.0 ? 1.0 : t);
+    return static_cast<uint32_t>(std::llround(t * steps));
+}
+
+inline float DequantizeFloat(uint32_t value, float min, float max, int bits) {
+    uint32_t steps = (bits >= 32) ? 0xFFFFFFFFu : ((1u << bits) - 1);
+    return static_cast<float>(min + (static_cast<double>(max) - min) * (static_cast<double>(value) / steps));
+}
+
+// Number of bits needed to cover a range at the given resolution
+inline int BitsForRange(float range, float resolution) {
+    if (range <= 0.0f || resolution <= 0.0f) return 1;
+    double steps = std::ceil(static_cast<double>(range) / resolution);
+    int bits = 1;
+    while (bits < 32 && static_cast<double>((1ull << bits) - 1) < steps) {
+        ++bits;
+    }
+    return bits;
+}
+
 // Generic entity snapshot
 struct EntitySnapshot {
     uint32_t entityID = 0;
@@ -68,37 +216,8 @@ struct EntitySnapshot {
     bool flipX = false;
     bool flipY = false;
     int currentFrame = 0;
-
-    // Serialization
-    std::string Serialize() const {
-        std::ostringstream oss;
-        oss << entityID << " "
-            << position.x << " " << position.y << " "
-            << velocity.x << " " << velocity.y << " "
-            << scale.x << " " << scale.y << " "
-            << rotation << " "
-            << (flipX ? 1 : 0) << " " << (flipY ? 1 : 0) << " "
-            << currentFrame;
-        return oss.str();
-    }
-
-    static EntitySnapshot Deserialize(std::istringstream& iss) {
-        EntitySnapshot snapshot;
-        int flipXInt, flipYInt;
-
-        iss >> snapshot.entityID
-            >> snapshot.position.x >> snapshot.position.y
-            >> snapshot.velocity.x >> snapshot.velocity.y
-            >> snapshot.scale.x >> snapshot.scale.y
-            >> snapshot.rotation
-            >> flipXInt >> flipYInt
-            >> snapshot.currentFrame;
-
-        snapshot.flipX = (flipXInt != 0);
-        snapshot.flipY = (flipYInt != 0);
-
-        return snapshot;
-    }
+    bool hasScale = true;       // Scale is only sent for a while after it changes
+    uint8_t profileIndex = 0;   // Index into GameStateSnapshot::profiles
 };
 
 // Complete game state snapshot
@@ -107,36 +226,187 @@ struct GameStateSnapshot {
     std::unordered_map<uint32_t, uint32_t> playerEntityBindings;  // clientID -> entityID
     uint64_t timestamp = 0;
 
-    // Serialization
+    // Quantization context, positions are encoded relative to the world bounds
+    Vec2 worldMin = Vec2(-65536.0f, -65536.0f);
+    Vec2 worldMax = Vec2(65536.0f, 65536.0f);
+    std::vector<QuantizationProfile> profiles = { QuantizationProfile() };
+
+    static constexpr int MAX_PROFILES = 16;
+
+    // Encoded size of everything except the entities, in bits
+    size_t EstimateHeaderBits() const {
+        return 64 + 128 + 5 + profiles.size() * 74 + 32 + 16 + playerEntityBindings.size() * 64;
+    }
+
+    // Upper bound on one entity's encoded size in bits (assumes a full 32-bit ID)
+    size_t EstimateEntityBits(const EntitySnapshot& entity) const {
+        const QuantizationProfile& profile = profiles[entity.profileIndex < profiles.size() ? entity.profileIndex : 0];
+        size_t bits = 34 + 9;
+        bits += BitsForRange(worldMax.x - worldMin.x, profile.positionResolution);
+        bits += BitsForRange(worldMax.y - worldMin.y, profile.positionResolution);
+        bits += profile.rotationBits;
+        if (entity.velocity.x != 0.0f || entity.velocity.y != 0.0f) bits += 2 * profile.velocityBits;
+        if (entity.currentFrame != 0) bits += 16;
+        if (entity.hasScale) bits += 64;
+        return bits;
+    }
+
+    // Serialization (bit-packed binary, entities are sorted by ID so IDs are delta coded)
     std::string Serialize() const {
-        std::ostringstream oss;
-        oss << timestamp << " " << entities.size() << " " << playerEntityBindings.size();
+        BitWriter writer;
+        writer.Write(static_cast<uint32_t>(timestamp & 0xFFFFFFFFull), 32);
+        writer.Write(static_cast<uint32_t>(timestamp >> 32), 32);
+        writer.WriteFloat(worldMin.x);
+        writer.WriteFloat(worldMin.y);
+        writer.WriteFloat(worldMax.x);
+        writer.WriteFloat(worldMax.y);
+
+        writer.Write(static_cast<uint32_t>(profiles.size()), 5);
+        for (const QuantizationProfile& profile : profiles) {
+            writer.WriteFloat(profile.positionResolution);
+            writer.Write(static_cast<uint32_t>(profile.rotationBits), 5);
+            writer.Write(static_cast<uint32_t>(profile.velocityBits), 5);
+            writer.WriteFloat(profile.maxVelocity);
+        }
 
-        for (const auto& entity : entities) {
-            oss << " " << entity.Serialize();
+        std::vector<const EntitySnapshot*> sorted;
+        sorted.reserve(entities.size());
+        for (const EntitySnapshot& entity : entities) {
+            sorted.push_back(&entity);
+        }
+        std::sort(sorted.begin(), sorted.end(), [](const EntitySnapshot* a, const EntitySnapshot* b) {
+            return a->entityID < b->entityID;
+        });
+
+        writer.Write(static_cast<uint32_t>(sorted.size()), 32);
+        uint32_t previousID = 0;
+        for (const EntitySnapshot* entity : sorted) {
+            // 0 = next ID, 10 = 8-bit delta, 11 = full ID
+            uint32_t delta = entity->entityID - previousID;
+            if (delta == 1) {
+                writer.Write(0, 1);
+            } else if (delta > 0 && delta < 256) {
+                writer.Write(1, 2);
+                writer.Write(delta, 8);
+            } else {
+                writer.Write(3, 2);
+                writer.Write(entity->entityID, 32);
+            }
+            previousID = entity->entityID;
+
+            const QuantizationProfile& profile = profiles[entity->profileIndex < profiles.size() ? entity->profileIndex : 0];
+            bool moving = entity->velocity.x != 0.0f || entity->velocity.y != 0.0f;
+            int positionBitsX = BitsForRange(worldMax.x - worldMin.x, profile.positionResolution);
+            int positionBitsY = BitsForRange(worldMax.y - worldMin.y, profile.positionResolution);
+
+            writer.Write(entity->profileIndex, 4);
+            writer.WriteBool(entity->flipX);
+            writer.WriteBool(entity->flipY);
+            writer.WriteBool(entity->hasScale);
+            writer.WriteBool(moving);
+            writer.WriteBool(entity->currentFrame != 0);
+
+            writer.Write(QuantizeFloat(entity->position.x, worldMin.x, worldMax.x, positionBitsX), positionBitsX);
+            writer.Write(QuantizeFloat(entity->position.y, worldMin.y, worldMax.y, positionBitsY), positionBitsY);
+
+            float rotation = std::fmod(entity->rotation, 360.0f);
+            if (rotation < 0.0f) rotation += 360.0f;
+            writer.Write(QuantizeFloat(rotation, 0.0f, 360.0f, profile.rotationBits), profile.rotationBits);
+
+            if (moving) {
+                writer.Write(QuantizeFloat(entity->velocity.x, -profile.maxVelocity, profile.maxVelocity, profile.velocityBits), profile.velocityBits);
+                writer.Write(QuantizeFloat(entity->velocity.y, -profile.maxVelocity, profile.maxVelocity, profile.velocityBits), profile.velocityBits);
+            }
+            if (entity->currentFrame != 0) {
+                writer.Write(static_cast<uint32_t>(entity->currentFrame), 16);
+            }
+            if (entity->hasScale) {
+                writer.WriteFloat(entity->scale.x);
+                writer.WriteFloat(entity->scale.y);
+            }
         }
 
+        writer.Write(static_cast<uint32_t>(playerEntityBindings.size()), 16);
         for (const auto& [clientID, entityID] : playerEntityBindings) {
-            oss << " " << clientID << " " << entityID;
+            writer.Write(clientID, 32);
+            writer.Write(entityID, 32);
         }
 
-        return oss.str();
+        return std::move(writer.Finish());
     }
 
     static GameStateSnapshot Deserialize(const std::string& data) {
         GameStateSnapshot snapshot;
-        std::istringstream iss(data);
-
-        size_t entityCount, bindingCount;
-        iss >> snapshot.timestamp >> entityCount >> bindingCount;
+        BitReader reader(data);
+
+        uint64_t timestampLow = reader.Read(32);
+        uint64_t timestampHigh = reader.Read(32);
+        snapshot.timestamp = timestampLow | (timestampHigh << 32);
+        snapshot.worldMin.x = reader.ReadFloat();
+        snapshot.worldMin.y = reader.ReadFloat();
+        snapshot.worldMax.x = reader.ReadFloat();
+        snapshot.worldMax.y = reader.ReadFloat();
+
+        uint32_t profileCount = reader.Read(5);
+        snapshot.profiles.clear();
+        for (uint32_t i = 0; i < profileCount; ++i) {
+            QuantizationProfile profile;
+            profile.positionResolution = reader.ReadFloat();
+            profile.rotationBits = static_cast<int>(reader.Read(5));
+            profile.velocityBits = static_cast<int>(reader.Read(5));
+            profile.maxVelocity = reader.ReadFloat();
+            snapshot.profiles.push_back(profile);
+        }
+        if (snapshot.profiles.empty()) {
+            snapshot.profiles.push_back(QuantizationProfile());
+        }
 
-        for (size_t i = 0; i < entityCount; ++i) {
-            snapshot.entities.push_back(EntitySnapshot::Deserialize(iss));
+        uint32_t entityCount = reader.Read(32);
+        uint32_t previousID = 0;
+        for (uint32_t i = 0; i < entityCount && !reader.HasOverflowed(); ++i) {
+            EntitySnapshot entity;
+            if (reader.Read(1) == 0) {
+                entity.entityID = previousID + 1;
+            } else if (reader.Read(1) == 0) {
+                entity.entityID = previousID + reader.Read(8);
+            } else {
+                entity.entityID = reader.Read(32);
+            }
+            previousID = entity.entityID;
+
+            entity.profileIndex = static_cast<uint8_t>(reader.Read(4));
+            const QuantizationProfile& profile = snapshot.profiles[entity.profileIndex < snapshot.profiles.size() ? entity.profileIndex : 0];
+            entity.flipX = reader.ReadBool();
+            entity.flipY = reader.ReadBool();
+            entity.hasScale = reader.ReadBool();
+            bool moving = reader.ReadBool();
+            bool hasFrame = reader.ReadBool();
+
+            int positionBitsX = BitsForRange(snapshot.worldMax.x - snapshot.worldMin.x, profile.positionResolution);
+            int positionBitsY = BitsForRange(snapshot.worldMax.y - snapshot.worldMin.y, profile.positionResolution);
+            entity.position.x = DequantizeFloat(reader.Read(positionBitsX), snapshot.worldMin.x, snapshot.worldMax.x, positionBitsX);
+            entity.position.y = DequantizeFloat(reader.Read(positionBitsY), snapshot.worldMin.y, snapshot.worldMax.y, positionBitsY);
+            entity.rotation = DequantizeFloat(reader.Read(profile.rotationBits), 0.0f, 360.0f, profile.rotationBits);
+
+            if (moving) {
+                entity.velocity.x = DequantizeFloat(reader.Read(profile.velocityBits), -profile.maxVelocity, profile.maxVelocity, profile.velocityBits);
+                entity.velocity.y = DequantizeFloat(reader.Read(profile.velocityBits), -profile.maxVelocity, profile.maxVelocity, profile.velocityBits);
+            }
+            if (hasFrame) {
+                entity.currentFrame = static_cast<int>(reader.Read(16));
+            }
+            if (entity.hasScale) {
+                entity.scale.x = reader.ReadFloat();
+                entity.scale.y = reader.ReadFloat();
+            }
+
+            snapshot.entities.push_back(entity);
         }
 
-        for (size_t i = 0; i < bindingCount; ++i) {
-            uint32_t clientID, entityID;
-            iss >> clientID >> entityID;
+        uint32_t bindingCount = reader.Read(16);
+        for (uint32_t i = 0; i < bindingCount && !reader.HasOverflowed(); ++i) {
+            uint32_t clientID = reader.Read(32);
+            uint32_t entityID = reader.Read(32);
             snapshot.playerEntityBindings[clientID] = entityID;
         }
 
@@ -156,6 +426,7 @@ struct EntitySpawnInfo {
     bool physEnabled = false;
     int colliderType = 0;
     uint32_t ownerClientID = 0;  // 0 = shared, non-zero = owned by that client
+    QuantizationProfile quantization;  // Snapshot precision for this entity's class
 
     // Serialization
     std::string Serialize() const {
@@ -169,7 +440,11 @@ struct EntitySpawnInfo {
             << rotation << " "
             << (physEnabled ? 1 : 0) << " "
             << colliderType << " "
-            << ownerClientID;
+            << ownerClientID << " "
+            << quantization.positionResolution << " "
+            << quantization.rotationBits << " "
+            << quantization.velocityBits << " "
+            << quantization.maxVelocity;
         return oss.str();
     }
 
@@ -198,10 +473,138 @@ struct EntitySpawnInfo {
 
         info.physEnabled = (physInt != 0);
 
+        // Precision fields are optional, missing values keep the default profile
+        QuantizationProfile quantization;
+        if (iss >> quantization.positionResolution >> quantization.rotationBits
+                >> quantization.velocityBits >> quantization.maxVelocity) {
+            info.quantization = quantization;
+        }
+
         return info;
     }
 };
 
+// Spawns for the world a client joins into, split into chunks that decode independently
+// so they can be streamed over several replies
+struct WorldStateChunk {
+    uint32_t chunkIndex = 0;
+    uint32_t chunkCount = 0;
+    std::vector<EntitySpawnInfo> spawns;
+
+    // Serialization (bit-packed binary, sprite paths and quantization profiles are stored once per chunk)
+    std::string Serialize() const {
+        std::vector<std::string> paths;
+        std::unordered_map<std::string, uint32_t> pathIndices;
+        std::vector<QuantizationProfile> profiles;
+        std::vector<uint32_t> entityPaths;
+        std::vector<uint32_t> entityProfiles;
+        entityPaths.reserve(spawns.size());
+        entityProfiles.reserve(spawns.size());
+
+        for (const EntitySpawnInfo& spawn : spawns) {
+            auto [it, inserted] = pathIndices.try_emplace(spawn.spritePath, static_cast<uint32_t>(paths.size()));
+            if (inserted) {
+                paths.push_back(spawn.spritePath);
+            }
+            entityPaths.push_back(it->second);
+
+            auto profileIt = std::find(profiles.begin(), profiles.end(), spawn.quantization);
+            if (profileIt == profiles.end()) {
+                profiles.push_back(spawn.quantization);
+                profileIt = profiles.end() - 1;
+            }
+            entityProfiles.push_back(static_cast<uint32_t>(profileIt - profiles.begin()));
+        }
+
+        BitWriter writer;
+        writer.Write(chunkIndex, 32);
+        writer.Write(chunkCount, 32);
+
+        writer.Write(static_cast<uint32_t>(paths.size()), 16);
+        for (const std::string& path : paths) {
+            writer.WriteString(path);
+        }
+
+        writer.Write(static_cast<uint32_t>(profiles.size()), 16);
+        for (const QuantizationProfile& profile : profiles) {
+            writer.WriteFloat(profile.positionResolution);
+            writer.Write(static_cast<uint32_t>(profile.rotationBits), 5);
+            writer.Write(static_cast<uint32_t>(profile.velocityBits), 5);
+            writer.WriteFloat(profile.maxVelocity);
+        }
+
+        writer.Write(static_cast<uint32_t>(spawns.size()), 32);
+        for (size_t i = 0; i < spawns.size(); ++i) {
+            const EntitySpawnInfo& spawn = spawns[i];
+            writer.Write(spawn.entityID, 32);
+            writer.Write(entityPaths[i], 16);
+            writer.Write(entityProfiles[i], 16);
+            writer.Write(static_cast<uint32_t>(spawn.totalFrames), 16);
+            writer.WriteFloat(spawn.fps);
+            writer.WriteFloat(spawn.position.x);
+            writer.WriteFloat(spawn.position.y);
+            writer.WriteFloat(spawn.scale.x);
+            writer.WriteFloat(spawn.scale.y);
+            writer.WriteFloat(spawn.rotation);
+            writer.WriteBool(spawn.physEnabled);
+            writer.Write(static_cast<uint32_t>(spawn.colliderType), 8);
+            writer.WriteBool(spawn.ownerClientID != 0);
+            if (spawn.ownerClientID != 0) {
+                writer.Write(spawn.ownerClientID, 32);
+            }
+        }
+
+        return std::move(writer.Finish());
+    }
+
+    static WorldStateChunk Deserialize(const std::string& data) {
+        WorldStateChunk chunk;
+        BitReader reader(data);
+
+        chunk.chunkIndex = reader.Read(32);
+        chunk.chunkCount = reader.Read(32);
+
+        std::vector<std::string> paths(reader.Read(16));
+        for (std::string& path : paths) {
+            path = reader.ReadString();
+        }
+
+        std::vector<QuantizationProfile> profiles(reader.Read(16));
+        for (QuantizationProfile& profile : profiles) {
+            profile.positionResolution = reader.ReadFloat();
+            profile.rotationBits = static_cast<int>(reader.Read(5));
+            profile.velocityBits = static_cast<int>(reader.Read(5));
+            profile.maxVelocity = reader.ReadFloat();
+        }
+
+        uint32_t spawnCount = reader.Read(32);
+        for (uint32_t i = 0; i < spawnCount && !reader.HasOverflowed(); ++i) {
+            EntitySpawnInfo spawn;
+            spawn.entityID = reader.Read(32);
+            uint32_t pathIndex = reader.Read(16);
+            uint32_t profileIndex = reader.Read(16);
+            spawn.totalFrames = static_cast<int>(reader.Read(16));
+            spawn.fps = reader.ReadFloat();
+            spawn.position.x = reader.ReadFloat();
+            spawn.position.y = reader.ReadFloat();
+            spawn.scale.x = reader.ReadFloat();
+            spawn.scale.y = reader.ReadFloat();
+            spawn.rotation = reader.ReadFloat();
+            spawn.physEnabled = reader.ReadBool();
+            spawn.colliderType = static_cast<int>(reader.Read(8));
+            if (reader.ReadBool()) {
+                spawn.ownerClientID = reader.Read(32);
+            }
+
+            if (pathIndex < paths.size()) spawn.spritePath = paths[pathIndex];
+            if (profileIndex < profiles.size()) spawn.quantization = profiles[profileIndex];
+            if (!reader.HasOverflowed()) chunk.spawns.push_back(std::move(spawn));
+        }
+
+        return chunk;
+    }
+};
+
 // Message types for network protocol
 enum class MessageType {
     CONNECT,
@@ -209,7 +612,8 @@ enum class MessageType {
     INPUT,              // Client -> Server
     GAME_STATE,         // Server -> Client
     SPAWN_ENTITY,       // Server -> Client (spawn new entity)
-    DESPAWN_ENTITY      // Server -> Client (remove entity)
+    DESPAWN_ENTITY,     // Server -> Client (remove entity)
+    WORLD_STATE_CHUNK   // Server -> Client (bulk spawns for a joining client)
 };
 
 // Helper to create protocol messages
@@ -0,0 +1,82 @@
+#ifndef NETWORKSTATS_H
+#define NETWORKSTATS_H
+
+#include <atomic>
+#include <cstdint>
+
+namespace SquareCore {
+
+// Plain copy of a connection's counters at one point in time
+struct ConnectionStatsSample {
+    uint32_t clientID = 0;
+    uint64_t bytesSent = 0;
+    uint64_t bytesReceived = 0;
+    uint64_t messagesSent = 0;
+    uint64_t messagesReceived = 0;
+    uint64_t snapshotsSent = 0;        // Server: snapshots sent, client: new snapshots received
+    uint64_t snapshotsSkipped = 0;     // Ticks that never reached the peer beyond those the send rate drops
+    uint64_t snapshotsPrioritized = 0; // Server: snapshots re-encoded to fit the bandwidth budget instead of shared
+    uint64_t failedExchanges = 0;      // Requests that got no reply
+    uint64_t inputsReceived = 0;
+    uint64_t inputsOverwritten = 0;    // Inputs replaced before a simulation tick consumed them
+    uint32_t pendingInputs = 0;        // Inputs received since the last simulation tick
+    uint32_t tickLag = 0;              // Ticks between the newest tick and the last one sent
+    float roundTripMs = 0.0f;          // Smoothed, measured by the client
+    float snapshotAgeMs = 0.0f;        // Time between a tick's capture and it being sent
+};
+
+// Traffic counters for one connection, updated with relaxed atomics on the send/recv paths
+// so reading them never blocks the network threads
+struct ConnectionStats {
+    std::atomic<uint64_t> bytesSent{0};
+    std::atomic<uint64_t> bytesReceived{0};
+    std::atomic<uint64_t> messagesSent{0};
+    std::atomic<uint64_t> messagesReceived{0};
+    std::atomic<uint64_t> snapshotsSent{0};
+    std::atomic<uint64_t> snapshotsSkipped{0};
+    std::atomic<uint64_t> snapshotsPrioritized{0};
+    std::atomic<uint64_t> failedExchanges{0};
+    std::atomic<uint64_t> inputsReceived{0};
+    std::atomic<uint64_t> inputsOverwritten{0};
+    std::atomic<uint32_t> pendingInputs{0};
+    std::atomic<uint32_t> tickLag{0};
+    std::atomic<float> roundTripMs{0.0f};
+    std::atomic<float> snapshotAgeMs{0.0f};
+
+    void Add(std::atomic<uint64_t>& counter, uint64_t amount = 1) {
+        counter.fetch_add(amount, std::memory_order_relaxed);
+    }
+
+    // Exponentially smoothed so a single slow reply doesn't dominate
+    void AddRoundTrip(float sampleMs) {
+        float current = roundTripMs.load(std::memory_order_relaxed);
+        roundTripMs.store(current == 0.0f ? sampleMs : current + (sampleMs - current) * ROUND_TRIP_SMOOTHING,
+                          std::memory_order_relaxed);
+    }
+
+    ConnectionStatsSample Sample(uint32_t clientID = 0) const {
+        ConnectionStatsSample sample;
+        sample.clientID = clientID;
+        sample.bytesSent = bytesSent.load(std::memory_order_relaxed);
+        sample.bytesReceived = bytesReceived.load(std::memory_order_relaxed);
+        sample.messagesSent = messagesSent.load(std::memory_order_relaxed);
+        sample.messagesReceived = messagesReceived.load(std::memory_order_relaxed);
+        sample.snapshotsSent = snapshotsSent.load(std::memory_order_relaxed);
+        sample.snapshotsSkipped = snapshotsSkipped.load(std::memory_order_relaxed);
+        sample.snapshotsPrioritized = snapshotsPrioritized.load(std::memory_order_relaxed);
+        sample.failedExchanges = failedExchanges.load(std::memory_order_relaxed);
+        sample.inputsReceived = inputsReceived.load(std::memory_order_relaxed);
+        sample.inputsOverwritten = inputsOverwritten.load(std::memory_order_relaxed);
+        sample.pendingInputs = pendingInputs.load(std::memory_order_relaxed);
+        sample.tickLag = tickLag.load(std::memory_order_relaxed);
+        sample.roundTripMs = roundTripMs.load(std::memory_order_relaxed);
+        sample.snapshotAgeMs = snapshotAgeMs.load(std::memory_order_relaxed);
+        return sample;
+    }
+
+    static constexpr float ROUND_TRIP_SMOOTHING = 0.1f;
+};
+
+}
+
+#endif
@@ -1,10 +1,16 @@
 #include "Server.h"
 #include "Core/Script.h"
 #include <zmq/zmq.hpp>
+#include <json/json.hpp>
 #include <iostream>
 #include <sstream>
 #include <chrono>
 #include <thread>
+#include <algorithm>
+#include <cmath>
+#include <unordered_set>
+#include <limits>
+#include <fstream>
 
 namespace SquareCore {
 
@@ -13,6 +19,8 @@ static zmq::context_t context(1);
 static zmq::socket_t* acceptSocket = nullptr;
 
 Server::Server() {
+    serverSceneManager.SetEntityManager(&serverEntityManager);
+    serverSceneManager.SetPhysics(&serverPhysics);
 }
 
 Server::~Server() {
@@ -42,6 +50,10 @@ void Server::Start(const std::vector<Script*>& scripts) {
         std::thread listener(&Server::ConnectionListenerThread, this);
         listener.detach();
 
+        if (!statsDumpPath.empty()) {
+            statsDumpThread = std::thread(&Server::StatsDumpThread, this);
+        }
+
         // Run simulation loop in main thread
         SimulationLoop();
 
@@ -82,6 +94,11 @@ void Server::Stop() {
         clientConnections.clear();
     }
 
+    if (statsDumpThread.joinable()) {
+        statsDumpThread.join();
+    }
+
+    StopRecording();
     CleanupSockets();
     std::cout << "Server stopped successfully\n";
 }
@@ -242,6 +259,7 @@ void Server::ClientThread(uint32_t clientID, void* socketPtr) {
         }
     }
 
+    auto nextPoll = std::chrono::steady_clock::now();
     while (running.load() && conn && conn->active.load()) {
         try {
             // Receive input from client
@@ -250,6 +268,8 @@ void Server::ClientThread(uint32_t clientID, void* socketPtr) {
 
             if (result) {
                 std::string requestStr(static_cast<char*>(request.data()), request.size());
+                conn->stats.Add(conn->stats.bytesReceived, request.size());
+                conn->stats.Add(conn->stats.messagesReceived);
 
                 MessageType msgType;
                 std::string payload;
@@ -258,7 +278,14 @@ void Server::ClientThread(uint32_t clientID, void* socketPtr) {
                         // Parse and queue input
                         InputState input = InputState::Deserialize(payload);
                         input.clientID = clientID;
+                        if (recorder.IsRecording()) {
+                            recorder.Record(SessionRecordType::INPUT, input.Serialize());
+                        }
                         inputManager.QueueInput(input);
+
+                        conn->stats.Add(conn->stats.inputsReceived);
+                        conn->stats.pendingInputs.fetch_add(1, std::memory_order_relaxed);
+                        conn->stats.roundTripMs.store(input.roundTripMs, std::memory_order_relaxed);
                     } else if (msgType == MessageType::DISCONNECT) {
                         HandleDisconnect(clientID);
                         conn->active = false;
@@ -266,44 +293,121 @@ void Server::ClientThread(uint32_t clientID, void* socketPtr) {
                     }
                 }
 
-                // Build response with queued messages and game state
+                // Build the per-client part of the response from queued messages
                 std::ostringstream response;
+                std::vector<std::string> worldChunks;
 
                 // Get and send queued spawn/despawn messages
                 {
                     std::lock_guard<std::mutex> queueLock(conn->queueMutex);
 
+                    // Stream a few world state chunks per reply while the client is joining
+                    while (!conn->worldStateChunks.empty() && worldChunks.size() < WORLD_CHUNKS_PER_REPLY) {
+                        worldChunks.push_back(std::move(conn->worldStateChunks.front()));
+                        conn->worldStateChunks.pop_front();
+                    }
+
                     // Send spawn messages
                     for (const auto& spawnInfo : conn->spawnQueue) {
                         response << CreateMessage(MessageType::SPAWN_ENTITY, spawnInfo.Serialize()) << "\n";
                     }
                     conn->spawnQueue.clear();
 
-                    // Send despawn messages
-                    for (uint32_t entityID : conn->despawnQueue) {
-                        response << CreateMessage(MessageType::DESPAWN_ENTITY, std::to_string(entityID)) << "\n";
+                    // Despawns wait until the world state is out, they may refer to entities in a later chunk
+                    if (conn->worldStateChunks.empty()) {
+                        for (uint32_t entityID : conn->despawnQueue) {
+                            response << CreateMessage(MessageType::DESPAWN_ENTITY, std::to_string(entityID)) << "\n";
+                        }
+                        conn->despawnQueue.clear();
                     }
-                    conn->despawnQueue.clear();
                 }
 
-                // Send latest game state
-                GameStateSnapshot latestState;
-                {
-                    std::lock_guard<std::mutex> lock(stateQueueMutex);
-                    if (!stateQueue.empty()) {
-                        latestState = stateQueue.back().snapshot;
+                std::shared_ptr<const EncodedGameState> state = GetLatestEncodedState();
+                std::string responseStr = response.str();
+
+                // Snapshots go out at the send rate, replies in between only carry queued messages.
+                // The latest tick already holds everything simulated since the previous send
+                float rate = sendRate.load();
+                if (state && rate > 0.0f) {
+                    auto now = std::chrono::high_resolution_clock::now();
+                    auto interval = std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+                        std::chrono::duration<float>(1.0f / rate));
+                    bool alreadySent = state->tick == conn->lastFullSendTick;
+                    if (now < conn->nextStateSendTime || alreadySent) {
+                        state.reset();
+                    } else if (conn->nextStateSendTime + interval < now) {
+                        conn->nextStateSendTime = now + interval;
+                    } else {
+                        conn->nextStateSendTime += interval;
                     }
                 }
 
-                response << CreateMessage(MessageType::GAME_STATE, latestState.Serialize());
+                // Queued messages go first in their own frame so the shared state frame is never copied
+                if (!responseStr.empty() || (!state && worldChunks.empty())) {
+                    zmq::message_t reply(responseStr.size());
+                    memcpy(reply.data(), responseStr.data(), responseStr.size());
+                    bool more = state || !worldChunks.empty();
+                    clientSocket->send(reply, more ? zmq::send_flags::sndmore : zmq::send_flags::none);
+                    conn->stats.Add(conn->stats.bytesSent, responseStr.size());
+                }
+                for (size_t i = 0; i < worldChunks.size(); ++i) {
+                    zmq::message_t chunkFrame(worldChunks[i].size());
+                    memcpy(chunkFrame.data(), worldChunks[i].data(), worldChunks[i].size());
+                    bool more = state || i + 1 < worldChunks.size();
+                    clientSocket->send(chunkFrame, more ? zmq::send_flags::sndmore : zmq::send_flags::none);
+                    conn->stats.Add(conn->stats.bytesSent, worldChunks[i].size());
+                }
+                conn->stats.Add(conn->stats.messagesSent);
+
+                if (state) {
+                    // Ticks between sends are expected below the tick rate, only count the ones beyond that
+                    uint64_t expectedGap = rate > 0.0f ? std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(tickRate.load() / rate))) : 1;
+                    uint64_t previousTick = conn->lastSentStateTick.exchange(state->tick);
+                    if (previousTick != 0 && state->tick > previousTick + expectedGap) {
+                        conn->stats.Add(conn->stats.snapshotsSkipped, state->tick - previousTick - expectedGap);
+                    }
+                    conn->stats.Add(conn->stats.snapshotsSent);
+                    conn->stats.snapshotAgeMs.store(std::chrono::duration<float, std::milli>(
+                        std::chrono::high_resolution_clock::now() - state->timestamp).count(), std::memory_order_relaxed);
+                }
 
-                std::string responseStr = response.str();
-                zmq::message_t reply(responseStr.size());
-                memcpy(reply.data(), responseStr.data(), responseStr.size());
-                clientSocket->send(reply, zmq::send_flags::none);
+                // Over budget, this client gets its own packet with the highest priority entities
+                uint32_t clientBudget = conn->bandwidthBudget.load();
+                if (clientBudget == 0) clientBudget = defaultBandwidthBudget.load();
+                bool limited = clientBudget != UNLIMITED_BANDWIDTH;
+                size_t budget = clientBudget;
+                if (limited) {
+                    budget = std::max(budget > responseStr.size() ? budget - responseStr.size() : 0, budget / 4);
+                }
+                if (state && limited && state->bytes.size() > budget) {
+                    std::string prioritized = BuildPrioritizedState(*conn, *state, budget);
+                    conn->stats.Add(conn->stats.snapshotsPrioritized);
+                    zmq::message_t stateFrame(prioritized.size());
+                    memcpy(stateFrame.data(), prioritized.data(), prioritized.size());
+                    clientSocket->send(stateFrame, zmq::send_flags::none);
+                    conn->stats.Add(conn->stats.bytesSent, prioritized.size());
+                } else if (state) {
+                    // Everything was sent, so every accumulator starts over
+                    conn->priorities.clear();
+                    conn->lastFullSendTick = state->tick;
+                    conn->lastReplyTick = state->tick;
+
+                    // The frame borrows the encoded bytes and holds a reference until zmq has sent them
+                    auto* stateRef = new std::shared_ptr<const EncodedGameState>(state);
+                    zmq::message_t stateFrame(const_cast<char*>(state->bytes.data()), state->bytes.size(),
+                        [](void*, void* hint) { delete static_cast<std::shared_ptr<const EncodedGameState>*>(hint); },
+                        stateRef);
+                    clientSocket->send(stateFrame, zmq::send_flags::none);
+                    conn->stats.Add(conn->stats.bytesSent, state->bytes.size());
+                }
             }
 
-            std::this_thread::sleep_for(std::chrono::milliseconds(16));
+            // Poll once per simulation tick, on a deadline so the cadence doesn't drift with the work done above.
+            // A late pass doesn't make the next ones rush
+            nextPoll += std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<float>(1.0f / tickRate.load()));
+            nextPoll = std::max(nextPoll, std::chrono::steady_clock::now());
+            std::this_thread::sleep_until(nextPoll);
 
         } catch (const zmq::error_t& e) {
             if (e.num() != ETERM && conn->active.load()) {
@@ -331,6 +435,13 @@ void Server::SimulationLoop() {
     auto lastTime = std::chrono::high_resolution_clock::now();
     float accumulator = 0.0f;
 
+    // Snapshots are stamped with the simulation time of their tick rather than the wall clock, so
+    // catch-up ticks stay distinct and clients can name the exact tick they were looking at
+    uint64_t simulationStartMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        lastTime.time_since_epoch()).count();
+    double simulationTimeMs = 0.0;
+    float historyTimestep = 0.0f;
+
     while (running.load()) {
         auto currentTime = std::chrono::high_resolution_clock::now();
         float deltaTime = std::chrono::duration<float>(currentTime - lastTime).count();
@@ -338,13 +449,23 @@ void Server::SimulationLoop() {
 
         accumulator += deltaTime;
 
+        // The tick rate may change between iterations, it is read once so every tick in a batch agrees
+        const float fixedTimestep = 1.0f / tickRate.load();
+        if (fixedTimestep != historyTimestep) {
+            // Enough history to rewind a client's view by LAG_COMPENSATION_MS at this rate
+            serverPhysics.SetHistoryCapacity(static_cast<size_t>(LAG_COMPENSATION_MS / (fixedTimestep * 1000.0f)) + 2);
+            historyTimestep = fixedTimestep;
+        }
+
         // Fixed timestep updates
-        while (accumulator >= FIXED_TIMESTEP) {
+        while (accumulator >= fixedTimestep) {
+            auto tickStart = std::chrono::high_resolution_clock::now();
+
             // Apply timeline scaling
-            float effectiveTimestep = serverTimeline.CalculateEffectiveTime(FIXED_TIMESTEP);
+            float effectiveTimestep = serverTimeline.CalculateEffectiveTime(fixedTimestep);
 
             // Update timeline
-            serverTimeline.Update(FIXED_TIMESTEP);
+            serverTimeline.Update(fixedTimestep);
 
             // Update physics
             serverPhysics.Update(effectiveTimestep);
@@ -356,30 +477,55 @@ void Server::SimulationLoop() {
             for (auto* script : scripts) 
                 script->OnUpdate(effectiveTimestep);
 
+            // Apply spawns and removals the scripts deferred
+            serverEntityManager.FlushCommands();
+
+            // Swap in a scene the scripts loaded in the background before this tick is captured
+            serverSceneManager.Update();
+
             // Capture game state
             GameStateSnapshot snapshot = CaptureGameState();
-            snapshot.timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
-                currentTime.time_since_epoch()).count();
-
-            // Push to state queue
-            {
-                std::lock_guard<std::mutex> lock(stateQueueMutex);
-                GameStatePacket packet;
-                packet.snapshot = snapshot;
-                packet.timestamp = currentTime;
-                stateQueue.push(packet);
-
-                // Keep only latest 5 states
-                while (stateQueue.size() > 5) {
-                    stateQueue.pop();
+            simulationTimeMs += fixedTimestep * 1000.0;
+            snapshot.timestamp = simulationStartMs + static_cast<uint64_t>(simulationTimeMs);
+
+            // Record where everything was this tick for lag-compensated queries
+            serverPhysics.RecordHistory(snapshot.timestamp);
+
+            // Encode once for every client and publish it
+            std::string statePayload = snapshot.Serialize();
+            if (recorder.IsRecording()) {
+                if (recordWorldStatePending.exchange(false)) {
+                    for (std::string& chunk : EncodeWorldState()) {
+                        recorder.Record(SessionRecordType::WORLD_STATE_CHUNK, std::move(chunk));
+                    }
                 }
+                recorder.Record(SessionRecordType::GAME_STATE, statePayload);
+            }
+            auto encoded = std::make_shared<EncodedGameState>();
+            encoded->bytes = CreateMessage(MessageType::GAME_STATE, statePayload);
+            encoded->timestamp = currentTime;
+            encoded->snapshot = std::move(snapshot);
+            encoded->tick = tickCount;
+            {
+                std::lock_guard<std::mutex> lock(latestStateMutex);
+                latestState = std::move(encoded);
+            }
+
+            UpdateTickTelemetry();
+
+            float tickMs = std::chrono::duration<float, std::milli>(std::chrono::high_resolution_clock::now() - tickStart).count();
+            lastTickMs = tickMs;
+            maxTickMs = std::max(maxTickMs.load(), tickMs);
+            simulatedTicks.fetch_add(1);
+            if (tickMs > fixedTimestep * 1000.0f) {
+                overrunTicks.fetch_add(1);
             }
 
-            accumulator -= FIXED_TIMESTEP;
+            accumulator -= fixedTimestep;
         }
 
-        // Sleep to maintain ~60Hz
-        std::this_thread::sleep_for(std::chrono::milliseconds(16));
+        // Sleep until the next tick is due
+        std::this_thread::sleep_for(std::chrono::duration<float>(fixedTimestep - accumulator));
     }
 
     std::cout << "Server simulation loop stopped\n";
@@ -391,18 +537,53 @@ GameStateSnapshot Server::CaptureGameState() {
     // Get all entities from server's entity manager
     std::vector<Entity> entities = serverEntityManager.GetEntitiesCopy();
 
-    for (const Entity& entity : entities) {
-        EntitySnapshot entitySnap;
-        entitySnap.entityID = entity.ID;
-        entitySnap.position = entity.position;
-        entitySnap.velocity = entity.velocity;
-        entitySnap.scale = entity.scale;
-        entitySnap.rotation = entity.rotation;
-        entitySnap.flipX = entity.flipX;
-        entitySnap.flipY = entity.flipY;
-        entitySnap.currentFrame = entity.currentFrame;
+    ++tickCount;
+    bool scaleKeyframe = (tickCount % SCALE_KEYFRAME_TICKS) == 0;
+
+    {
+        std::lock_guard<std::mutex> lock(quantizationMutex);
+        snapshot.worldMin = worldMin;
+        snapshot.worldMax = worldMax;
+        snapshot.profiles = quantizationProfiles;
+
+        snapshot.entities.reserve(entities.size());
+        for (const Entity& entity : entities) {
+            EntitySnapshot entitySnap;
+            entitySnap.entityID = entity.ID;
+            entitySnap.position = entity.position;
+            entitySnap.velocity = entity.velocity;
+            entitySnap.scale = entity.scale;
+            entitySnap.rotation = entity.rotation;
+            entitySnap.flipX = entity.flipX;
+            entitySnap.flipY = entity.flipY;
+            entitySnap.currentFrame = entity.currentFrame;
+
+            auto profileIt = entityProfiles.find(entity.ID);
+            entitySnap.profileIndex = profileIt != entityProfiles.end() ? profileIt->second : 0;
+
+            // Scale is sent for a window after it changes, spawn info carries the initial value
+            auto scaleIt = scaleTracks.find(entity.ID);
+            if (scaleIt == scaleTracks.end()) {
+                scaleTracks[entity.ID] = { entity.scale, tickCount };
+            } else if (!CompareFloats(scaleIt->second.scale.x, entity.scale.x) ||
+                       !CompareFloats(scaleIt->second.scale.y, entity.scale.y)) {
+                scaleIt->second = { entity.scale, tickCount };
+            }
+            entitySnap.hasScale = scaleKeyframe || (tickCount - scaleTracks[entity.ID].changedTick) < SCALE_RESEND_TICKS;
 
-        snapshot.entities.push_back(entitySnap);
+            snapshot.entities.push_back(entitySnap);
+        }
+    }
+
+    // Forget scale history for removed entities
+    if (scaleTracks.size() > entities.size()) {
+        std::unordered_set<uint32_t> alive;
+        for (const Entity& entity : entities) {
+            alive.insert(entity.ID);
+        }
+        for (auto it = scaleTracks.begin(); it != scaleTracks.end();) {
+            it = alive.count(it->first) ? std::next(it) : scaleTracks.erase(it);
+        }
     }
 
     // Add player bindings
@@ -414,6 +595,272 @@ GameStateSnapshot Server::CaptureGameState() {
     return snapshot;
 }
 
+std::shared_ptr<const Server::EncodedGameState> Server::GetLatestEncodedState() const {
+    std::lock_guard<std::mutex> lock(latestStateMutex);
+    return latestState;
+}
+
+std::string Server::BuildPrioritizedState(ClientConnection& conn, const EncodedGameState& state, size_t budgetBytes) {
+    const GameStateSnapshot& full = state.snapshot;
+    uint64_t elapsedTicks = state.tick > conn.lastReplyTick ? state.tick - conn.lastReplyTick : 0;
+    conn.lastReplyTick = state.tick;
+
+    // Distances are measured from this client's player, if it has one
+    uint32_t playerEntity = 0;
+    auto bindingIt = full.playerEntityBindings.find(conn.clientID);
+    if (bindingIt != full.playerEntityBindings.end()) {
+        playerEntity = bindingIt->second;
+    }
+    const EntitySnapshot* player = nullptr;
+    for (const EntitySnapshot& entity : full.entities) {
+        if (entity.entityID == playerEntity) {
+            player = &entity;
+            break;
+        }
+    }
+
+    // Accumulate priority for the ticks since the last reply, owned entities always go first
+    std::vector<std::pair<float, size_t>> order;
+    order.reserve(full.entities.size());
+    {
+        std::lock_guard<std::mutex> lock(entityOwnersMutex);
+        for (size_t i = 0; i < full.entities.size(); ++i) {
+            const EntitySnapshot& entity = full.entities[i];
+            auto ownerIt = entityOwners.find(entity.entityID);
+            bool owned = entity.entityID == playerEntity ||
+                         (ownerIt != entityOwners.end() && ownerIt->second == conn.clientID);
+
+            float distanceFactor = 1.0f;
+            if (player) {
+                float distance = entity.position.distance(player->position);
+                distanceFactor = 1.0f / (1.0f + distance / PRIORITY_DISTANCE_FALLOFF);
+            }
+            float velocityFactor = std::min(1.0f + entity.velocity.magnitude() / PRIORITY_VELOCITY_SCALE, MAX_VELOCITY_PRIORITY);
+
+            auto [it, inserted] = conn.priorities.try_emplace(entity.entityID);
+            if (inserted) {
+                it->second.lastSentTick = conn.lastFullSendTick;
+            }
+            it->second.accumulator += distanceFactor * velocityFactor * static_cast<float>(elapsedTicks);
+
+            order.emplace_back(owned ? std::numeric_limits<float>::max() : it->second.accumulator, i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    // Fill the packet by priority, entities that don't fit keep accumulating
+    GameStateSnapshot packet;
+    packet.timestamp = full.timestamp;
+    packet.worldMin = full.worldMin;
+    packet.worldMax = full.worldMax;
+    packet.profiles = full.profiles;
+    packet.playerEntityBindings = full.playerEntityBindings;
+
+    size_t prefixBits = CreateMessage(MessageType::GAME_STATE, " ").size() * 8;
+    size_t budgetBits = budgetBytes * 8;
+    size_t usedBits = prefixBits + packet.EstimateHeaderBits();
+    for (const auto& [priority, index] : order) {
+        EntitySnapshot entity = full.entities[index];
+        ClientConnection::EntityPriority& entry = conn.priorities[entity.entityID];
+
+        // A scale change may have happened entirely while this client wasn't being sent the entity
+        if (state.tick - entry.lastSentTick >= SCALE_RESEND_TICKS) {
+            entity.hasScale = true;
+        }
+
+        size_t bits = packet.EstimateEntityBits(entity);
+        if (usedBits + bits > budgetBits && priority != std::numeric_limits<float>::max()) {
+            continue;
+        }
+
+        usedBits += bits;
+        entry.accumulator = 0.0f;
+        entry.lastSentTick = state.tick;
+        packet.entities.push_back(entity);
+    }
+
+    // Forget priorities of removed entities
+    if (conn.priorities.size() > full.entities.size()) {
+        std::unordered_set<uint32_t> alive;
+        for (const EntitySnapshot& entity : full.entities) {
+            alive.insert(entity.entityID);
+        }
+        for (auto it = conn.priorities.begin(); it != conn.priorities.end();) {
+            it = alive.count(it->first) ? std::next(it) : conn.priorities.erase(it);
+        }
+    }
+
+    return CreateMessage(MessageType::GAME_STATE, packet.Serialize());
+}
+
+bool Server::SetTickRate(float ticksPerSecond) {
+    // Written so NaN is rejected too
+    if (!(ticksPerSecond > 0.0f && ticksPerSecond <= MAX_TICK_RATE)) {
+        std::cout << "Invalid tick rate " << ticksPerSecond << ", keeping " << tickRate.load() << " Hz\n";
+        return false;
+    }
+    tickRate = ticksPerSecond;
+    return true;
+}
+
+void Server::SetSendRate(float snapshotsPerSecond) {
+    sendRate = std::max(snapshotsPerSecond, 0.0f);
+}
+
+void Server::SetBandwidthBudget(uint32_t bytesPerTick) {
+    defaultBandwidthBudget = bytesPerTick == 0 ? DEFAULT_BANDWIDTH_BUDGET : bytesPerTick;
+}
+
+void Server::SetClientBandwidthBudget(uint32_t clientID, uint32_t bytesPerTick) {
+    std::lock_guard<std::mutex> lock(clientConnectionsMutex);
+    for (auto& conn : clientConnections) {
+        if (conn->clientID == clientID) {
+            conn->bandwidthBudget = bytesPerTick;
+            break;
+        }
+    }
+}
+
+ServerTickStats Server::GetTickStats() const {
+    ServerTickStats stats;
+    stats.ticks = simulatedTicks.load();
+    stats.overruns = overrunTicks.load();
+    stats.lastTickMs = lastTickMs.load();
+    stats.maxTickMs = maxTickMs.load();
+    return stats;
+}
+
+std::vector<ConnectionStatsSample> Server::GetConnectionStats() const {
+    std::lock_guard<std::mutex> lock(clientConnectionsMutex);
+    std::vector<ConnectionStatsSample> samples;
+    for (const auto& conn : clientConnections) {
+        if (conn->active.load()) {
+            samples.push_back(conn->stats.Sample(conn->clientID));
+        }
+    }
+    return samples;
+}
+
+void Server::UpdateTickTelemetry() {
+    std::lock_guard<std::mutex> lock(clientConnectionsMutex);
+    for (auto& conn : clientConnections) {
+        // Input is latest-wins, so everything but the last input since the previous tick was never simulated
+        uint32_t pending = conn->stats.pendingInputs.exchange(0, std::memory_order_relaxed);
+        if (pending > 1) {
+            conn->stats.Add(conn->stats.inputsOverwritten, pending - 1);
+        }
+
+        uint64_t lastSent = conn->lastSentStateTick.load();
+        conn->stats.tickLag.store(lastSent != 0 && tickCount > lastSent ? static_cast<uint32_t>(tickCount - lastSent) : 0,
+                                  std::memory_order_relaxed);
+    }
+}
+
+void Server::EnableStatsDump(const std::string& path, float intervalSeconds) {
+    if (running.load()) {
+        std::cout << "Stats dump must be enabled before the server starts\n";
+        return;
+    }
+    statsDumpPath = path;
+    statsDumpInterval = std::max(intervalSeconds, 0.1f);
+}
+
+void Server::StatsDumpThread() {
+    std::ofstream file(statsDumpPath, std::ios::app);
+    if (!file.is_open()) {
+        std::cout << "Failed to open stats dump file " << statsDumpPath << "\n";
+        return;
+    }
+
+    bool json = statsDumpPath.size() >= 5 && statsDumpPath.compare(statsDumpPath.size() - 5, 5, ".json") == 0;
+    if (!json && file.tellp() == 0) {
+        file << "timeSeconds,clientId,roundTripMs,sentBytesPerSecond,receivedBytesPerSecond,snapshotsSent,"
+                "snapshotsSkipped,snapshotsPrioritized,snapshotAgeMs,tickLag,inputsReceived,inputsOverwritten\n";
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto lastDump = start;
+    std::unordered_map<uint32_t, ConnectionStatsSample> previous;
+
+    while (running.load()) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto now = std::chrono::steady_clock::now();
+        float elapsed = std::chrono::duration<float>(now - lastDump).count();
+        if (elapsed < statsDumpInterval) continue;
+        lastDump = now;
+
+        float time = std::chrono::duration<float>(now - start).count();
+        std::unordered_map<uint32_t, ConnectionStatsSample> current;
+        for (const ConnectionStatsSample& sample : GetConnectionStats()) {
+            // Rates are over the dump interval, a client's first row counts from zero
+            const ConnectionStatsSample& before = previous.count(sample.clientID) ? previous[sample.clientID] : ConnectionStatsSample();
+            float sentRate = (sample.bytesSent - before.bytesSent) / elapsed;
+            float receivedRate = (sample.bytesReceived - before.bytesReceived) / elapsed;
+
+            if (json) {
+                nlohmann::json row = {
+                    {"timeSeconds", time},
+                    {"clientId", sample.clientID},
+                    {"roundTripMs", sample.roundTripMs},
+                    {"sentBytesPerSecond", sentRate},
+                    {"receivedBytesPerSecond", receivedRate},
+                    {"snapshotsSent", sample.snapshotsSent},
+                    {"snapshotsSkipped", sample.snapshotsSkipped},
+                    {"snapshotsPrioritized", sample.snapshotsPrioritized},
+                    {"snapshotAgeMs", sample.snapshotAgeMs},
+                    {"tickLag", sample.tickLag},
+                    {"inputsReceived", sample.inputsReceived},
+                    {"inputsOverwritten", sample.inputsOverwritten}
+                };
+                file << row.dump() << "\n";
+            } else {
+                file << time << "," << sample.clientID << "," << sample.roundTripMs << "," << sentRate << ","
+                     << receivedRate << "," << sample.snapshotsSent << "," << sample.snapshotsSkipped << ","
+                     << sample.snapshotsPrioritized << "," << sample.snapshotAgeMs << "," << sample.tickLag << "," << sample.inputsReceived << ","
+                     << sample.inputsOverwritten << "\n";
+            }
+            current[sample.clientID] = sample;
+        }
+        file.flush();
+        previous = std::move(current);
+    }
+}
+
+void Server::SetWorldBounds(const Vec2& min, const Vec2& max) {
+    std::lock_guard<std::mutex> lock(quantizationMutex);
+    worldMin = min;
+    worldMax = max;
+}
+
+uint8_t Server::RegisterQuantizationProfile(uint32_t entityID, const QuantizationProfile& profile) {
+    std::lock_guard<std::mutex> lock(quantizationMutex);
+
+    uint8_t index = 0;
+    auto it = std::find(quantizationProfiles.begin(), quantizationProfiles.end(), profile);
+    if (it != quantizationProfiles.end()) {
+        index = static_cast<uint8_t>(it - quantizationProfiles.begin());
+    } else if (quantizationProfiles.size() < GameStateSnapshot::MAX_PROFILES) {
+        quantizationProfiles.push_back(profile);
+        index = static_cast<uint8_t>(quantizationProfiles.size() - 1);
+    } else {
+        std::cout << "Too many quantization profiles, entity " << entityID << " uses the default\n";
+    }
+
+    if (index == 0) {
+        entityProfiles.erase(entityID);
+    } else {
+        entityProfiles[entityID] = index;
+    }
+    return index;
+}
+
+QuantizationProfile Server::GetQuantizationProfile(uint32_t entityID) const {
+    std::lock_guard<std::mutex> lock(quantizationMutex);
+    auto it = entityProfiles.find(entityID);
+    return it != entityProfiles.end() ? quantizationProfiles[it->second] : quantizationProfiles[0];
+}
+
 void Server::RegisterPlayerEntity(uint32_t clientID, uint32_t entityID) {
     std::lock_guard<std::mutex> lock(clientPlayerMutex);
     clientPlayerMap[clientID] = entityID;
@@ -456,18 +903,34 @@ void Server::BroadcastEntitySpawn(const EntitySpawnInfo& spawnInfo, uint32_t own
     EntitySpawnInfo spawnInfoWithOwner = spawnInfo;
     spawnInfoWithOwner.ownerClientID = ownerClientID;
 
+    RegisterQuantizationProfile(spawnInfo.entityID, spawnInfo.quantization);
+    if (ownerClientID != 0) {
+        std::lock_guard<std::mutex> ownersLock(entityOwnersMutex);
+        entityOwners[spawnInfo.entityID] = ownerClientID;
+    }
+
     for (auto& conn : clientConnections) {
         if (conn->active.load() && conn->clientID != excludeClientID) {
             std::lock_guard<std::mutex> queueLock(conn->queueMutex);
             conn->spawnQueue.push_back(spawnInfoWithOwner);
         }
     }
+    recorder.Record(SessionRecordType::SPAWN, spawnInfoWithOwner.Serialize());
 
     std::cout << "Broadcasted entity spawn (ID: " << spawnInfo.entityID << ") to "
               << clientConnections.size() << " clients (owner: " << ownerClientID << ")\n";
 }
 
 void Server::BroadcastEntityDespawn(uint32_t entityID, uint32_t excludeClientID) {
+    {
+        std::lock_guard<std::mutex> quantizationLock(quantizationMutex);
+        entityProfiles.erase(entityID);
+    }
+    {
+        std::lock_guard<std::mutex> ownersLock(entityOwnersMutex);
+        entityOwners.erase(entityID);
+    }
+
     std::lock_guard<std::mutex> lock(clientConnectionsMutex);
 
     for (auto& conn : clientConnections) {
@@ -476,21 +939,38 @@ void Server::BroadcastEntityDespawn(uint32_t entityID, uint32_t excludeClientID)
             conn->despawnQueue.push_back(entityID);
         }
     }
+    recorder.Record(SessionRecordType::DESPAWN, std::to_string(entityID));
 
     std::cout << "Broadcasted entity despawn (ID: " << entityID << ") to "
               << clientConnections.size() << " clients\n";
 }
 
-void Server::SendWorldStateToClient(uint32_t clientID) {
-    // Get all entities from entity manager
-    std::vector<Entity> entities = serverEntityManager.GetEntitiesCopy();
+std::vector<std::string> Server::EncodeWorldState() {
+    std::unordered_map<uint32_t, uint8_t> profileIndices;
+    std::vector<QuantizationProfile> profiles;
+    {
+        std::lock_guard<std::mutex> lock(quantizationMutex);
+        profileIndices = entityProfiles;
+        profiles = quantizationProfiles;
+    }
+    std::unordered_map<uint32_t, uint32_t> owners;
+    {
+        std::lock_guard<std::mutex> lock(entityOwnersMutex);
+        owners = entityOwners;
+    }
+
+    // Encode every entity into chunks in one pass under the entity lock, without copying the entity list
+    std::vector<std::string> chunks;
+    std::lock_guard<std::mutex> lock(serverEntityManager.GetMutex());
+    const std::vector<Entity>& entities = serverEntityManager.GetEntitiesUnsafe();
 
-    std::cout << "Sending world state to client " << clientID
-              << " (" << entities.size() << " entities)\n";
+    uint32_t chunkCount = static_cast<uint32_t>((entities.size() + WORLD_CHUNK_ENTITIES - 1) / WORLD_CHUNK_ENTITIES);
+    WorldStateChunk chunk;
+    chunk.chunkCount = chunkCount;
+    chunk.spawns.reserve(std::min<size_t>(entities.size(), WORLD_CHUNK_ENTITIES));
 
-    // For each entity, create a spawn message and queue it
     for (const Entity& entity : entities) {
-        EntitySpawnInfo spawnInfo;
+        EntitySpawnInfo& spawnInfo = chunk.spawns.emplace_back();
         spawnInfo.entityID = entity.ID;
         spawnInfo.spritePath = entity.spritePath;
         spawnInfo.totalFrames = entity.totalFrames;
@@ -501,16 +981,57 @@ void Server::SendWorldStateToClient(uint32_t clientID) {
         spawnInfo.physEnabled = entity.physApplied;
         spawnInfo.colliderType = static_cast<int>(entity.collider.type);
 
-        // Queue this spawn for the client
-        std::lock_guard<std::mutex> lock(clientConnectionsMutex);
-        for (auto& conn : clientConnections) {
-            if (conn->clientID == clientID) {
-                std::lock_guard<std::mutex> queueLock(conn->queueMutex);
-                conn->spawnQueue.push_back(spawnInfo);
-                break;
-            }
+        auto profileIt = profileIndices.find(entity.ID);
+        if (profileIt != profileIndices.end() && profileIt->second < profiles.size()) {
+            spawnInfo.quantization = profiles[profileIt->second];
+        }
+        auto ownerIt = owners.find(entity.ID);
+        if (ownerIt != owners.end()) {
+            spawnInfo.ownerClientID = ownerIt->second;
         }
+
+        if (chunk.spawns.size() == WORLD_CHUNK_ENTITIES) {
+            chunks.push_back(chunk.Serialize());
+            chunk.spawns.clear();
+            ++chunk.chunkIndex;
+        }
+    }
+    if (!chunk.spawns.empty()) {
+        chunks.push_back(chunk.Serialize());
+    }
+    return chunks;
+}
+
+void Server::SendWorldStateToClient(uint32_t clientID) {
+    std::vector<std::string> payloads = EncodeWorldState();
+    std::deque<std::string> chunks;
+    for (const std::string& payload : payloads) {
+        chunks.push_back(CreateMessage(MessageType::WORLD_STATE_CHUNK, payload));
     }
+
+    std::cout << "Sending world state to client " << clientID << " (" << chunks.size() << " chunks)\n";
+
+    std::lock_guard<std::mutex> lock(clientConnectionsMutex);
+    for (auto& conn : clientConnections) {
+        if (conn->clientID == clientID) {
+            std::lock_guard<std::mutex> queueLock(conn->queueMutex);
+            conn->worldStateChunks = std::move(chunks);
+            break;
+        }
+    }
+}
+
+bool Server::StartRecording(const std::string& path) {
+    if (!recorder.Open(path)) {
+        return false;
+    }
+    recordWorldStatePending = true;
+    return true;
+}
+
+void Server::StopRecording() {
+    recordWorldStatePending = false;
+    recorder.Close();
 }
 
 }
@@ -3,16 +3,21 @@
 
 #include "ServerInputManager.h"
 #include "NetworkProtocol.h"
+#include "NetworkStats.h"
+#include "SessionRecording.h"
 #include "Renderer/EntityManager.h"
 #include "Physics/Physics.h"
 #include "Core/Timeline.h"
+#include "Core/SceneManager.h"
 #include <unordered_map>
 #include <string>
 #include <chrono>
 #include <mutex>
 #include <atomic>
 #include <thread>
-#include <queue>
+#include <memory>
+#include <deque>
+#include <cstdint>
 
 namespace SquareCore {
 
@@ -28,7 +33,33 @@ struct ClientConnection {
     // Message queues for entity spawn/despawn
     std::vector<EntitySpawnInfo> spawnQueue;
     std::vector<uint32_t> despawnQueue;
+    std::deque<std::string> worldStateChunks;  // Encoded WORLD_STATE_CHUNK messages still to stream
     std::mutex queueMutex;
+
+    // Snapshot bytes allowed per reply, 0 = use the server default
+    std::atomic<uint32_t> bandwidthBudget{0};
+
+    // Per-entity send priority for this client (client thread only)
+    struct EntityPriority {
+        float accumulator = 0.0f;
+        uint64_t lastSentTick = 0;
+    };
+    std::unordered_map<uint32_t, EntityPriority> priorities;
+    uint64_t lastFullSendTick = 0;  // Entities missing from priorities were last sent on this tick
+    uint64_t lastReplyTick = 0;
+    std::chrono::high_resolution_clock::time_point nextStateSendTime;  // Paces snapshots to the send rate
+
+    // Telemetry, the tick of the last snapshot sent is also read by the simulation thread for tick lag
+    ConnectionStats stats;
+    std::atomic<uint64_t> lastSentStateTick{0};
+};
+
+// Simulation loop timing, a tick overruns when its work takes longer than the tick interval
+struct ServerTickStats {
+    uint64_t ticks = 0;
+    uint64_t overruns = 0;
+    float lastTickMs = 0.0f;
+    float maxTickMs = 0.0f;
 };
 
 class Server {
@@ -47,6 +78,8 @@ public:
     Physics& GetPhysics() { return serverPhysics; }
     // Get server's timeline (for game logic access)
     Timeline& GetTimeline() { return serverTimeline; }
+    // Get server's scene manager, loads are advanced by the simulation loop after the scripts (for game logic access)
+    SceneManager& GetSceneManager() { return serverSceneManager; }
     // Get server's input manager (for game logic access)
     ServerInputManager& GetInputManager() { return inputManager; }
 
@@ -60,6 +93,41 @@ public:
     // Get player entity ID for a client
     uint32_t GetPlayerEntityForClient(uint32_t clientID) const;
 
+    // Get simulation loop timing (thread-safe)
+    ServerTickStats GetTickStats() const;
+    // Get telemetry counters for every connected client (thread-safe)
+    std::vector<ConnectionStatsSample> GetConnectionStats() const;
+    // Periodically append connection stats to a file while running (.json writes JSON lines, anything else CSV)
+    void EnableStatsDump(const std::string& path, float intervalSeconds = 1.0f);
+
+    // Record the session (world state, spawns, despawns, every tick's snapshot and client inputs) to a
+    // file for replay through NetworkManager, written by a background thread
+    bool StartRecording(const std::string& path);
+    void StopRecording();
+
+    // Set the bounds snapshot positions are quantized against (entities outside are clamped)
+    void SetWorldBounds(const Vec2& min, const Vec2& max);
+
+    // Highest accepted tick rate
+    static constexpr float MAX_TICK_RATE = 240.0f;
+    // Simulation ticks per second (eg. 60, 120 or 128), takes effect on the next tick. Returns false and keeps
+    // the current rate if it is outside (0, MAX_TICK_RATE]
+    bool SetTickRate(float ticksPerSecond);
+    float GetTickRate() const { return tickRate.load(); }
+    // Snapshots per second sent to each client, independent of the tick rate; every snapshot carries
+    // the latest tick so nothing simulated in between is lost (0 = send on every client request)
+    void SetSendRate(float snapshotsPerSecond);
+    float GetSendRate() const { return sendRate.load(); }
+
+    // Budget that turns the bandwidth limit off, every reply carries the full snapshot (LAN, testing)
+    static constexpr uint32_t UNLIMITED_BANDWIDTH = UINT32_MAX;
+    // Snapshot bytes each client may receive per reply, lower priority entities wait for later replies.
+    // Off by default: a limited client gets its own re-encoded snapshot instead of the shared one, which costs
+    // a serialization per client per send (0 or UNLIMITED_BANDWIDTH = no limit)
+    void SetBandwidthBudget(uint32_t bytesPerTick);
+    // Override the bandwidth budget for one client (0 = use the server default, UNLIMITED_BANDWIDTH = no limit)
+    void SetClientBandwidthBudget(uint32_t clientID, uint32_t bytesPerTick);
+
     // Entity spawn/despawn broadcasting
     void BroadcastEntitySpawn(const EntitySpawnInfo& spawnInfo, uint32_t ownerClientID = 0, uint32_t excludeClientID = 0);
     void BroadcastEntityDespawn(uint32_t entityID, uint32_t excludeClientID = 0);
@@ -69,6 +137,7 @@ private:
     EntityManager serverEntityManager;
     Physics serverPhysics;
     Timeline serverTimeline;
+    SceneManager serverSceneManager;
     ServerInputManager inputManager;
     std::vector<Script*> scripts;
 
@@ -85,15 +154,56 @@ private:
     // Server running state
     std::atomic<bool> running{false};
 
-    // Game state queue for sending to clients
-    struct GameStatePacket {
-        GameStateSnapshot snapshot;
+    // Simulation loop timing, written by the simulation thread only
+    std::atomic<uint64_t> simulatedTicks{0};
+    std::atomic<uint64_t> overrunTicks{0};
+    std::atomic<float> lastTickMs{0.0f};
+    std::atomic<float> maxTickMs{0.0f};
+
+    // Optional periodic stats dump
+    std::string statsDumpPath;
+    float statsDumpInterval = 1.0f;
+    std::thread statsDumpThread;
+
+    // Game state encoded once per tick and shared read-only by every client thread
+    struct EncodedGameState {
+        std::string bytes;
         std::chrono::time_point<std::chrono::high_resolution_clock> timestamp;
+        GameStateSnapshot snapshot;  // Source of per-client packets when the full encoding is over budget
+        uint64_t tick = 0;
+    };
+    std::shared_ptr<const EncodedGameState> latestState;
+    mutable std::mutex latestStateMutex;
+
+    // Snapshot quantization state, profiles are registered from EntitySpawnInfo per entity
+    Vec2 worldMin = Vec2(-65536.0f, -65536.0f);
+    Vec2 worldMax = Vec2(65536.0f, 65536.0f);
+    std::vector<QuantizationProfile> quantizationProfiles = { QuantizationProfile() };
+    std::unordered_map<uint32_t, uint8_t> entityProfiles;
+    mutable std::mutex quantizationMutex;
+
+    // Last scale sent per entity and the tick it changed on (simulation thread only)
+    struct ScaleTrack {
+        Vec2 scale;
+        uint64_t changedTick;
     };
-    std::queue<GameStatePacket> stateQueue;
-    mutable std::mutex stateQueueMutex;
+    std::unordered_map<uint32_t, ScaleTrack> scaleTracks;
+    uint64_t tickCount = 0;
+
+    // Session recording, the world state is written by the simulation thread before the next snapshot
+    SessionRecorder recorder;
+    std::atomic<bool> recordWorldStatePending{false};
+
+    // Simulation and snapshot rates, adjustable while running
+    std::atomic<float> tickRate{DEFAULT_TICK_RATE};
+    std::atomic<float> sendRate{DEFAULT_SEND_RATE};
 
-    // Main simulation loop (runs game logic at 60Hz)
+    // Snapshot bandwidth limits and entity ownership used to prioritize entities per client
+    std::atomic<uint32_t> defaultBandwidthBudget{DEFAULT_BANDWIDTH_BUDGET};
+    std::unordered_map<uint32_t, uint32_t> entityOwners;  // entityID -> owner clientID
+    mutable std::mutex entityOwnersMutex;
+
+    // Main simulation loop (runs game logic at the tick rate)
     void SimulationLoop();
 
     // Per-client thread function
@@ -106,7 +216,13 @@ private:
 
     // Serialize current game state
     GameStateSnapshot CaptureGameState();
+    // Get the most recently published tick encoding (thread-safe)
+    std::shared_ptr<const EncodedGameState> GetLatestEncodedState() const;
+    // Encode the highest priority entities that fit in the client's budget (client thread only)
+    std::string BuildPrioritizedState(ClientConnection& conn, const EncodedGameState& state, size_t budgetBytes);
 
+    // Serialize every entity into WorldStateChunk payloads
+    std::vector<std::string> EncodeWorldState();
     // Send world state to newly connected client
     void SendWorldStateToClient(uint32_t clientID);
 
@@ -116,9 +232,35 @@ private:
 
     // Connection listener thread
     void ConnectionListenerThread();
+    // Writes connection stats to statsDumpPath every statsDumpInterval seconds
+    void StatsDumpThread();
+    // Per-tick telemetry that only the simulation thread can see (input overwrites, tick lag)
+    void UpdateTickTelemetry();
+
+    // Register an entity's quantization profile (returns its profile index)
+    uint8_t RegisterQuantizationProfile(uint32_t entityID, const QuantizationProfile& profile);
+    // Look up the quantization profile for an entity
+    QuantizationProfile GetQuantizationProfile(uint32_t entityID) const;
 
-    // Fixed timestep for simulation
-    static constexpr float FIXED_TIMESTEP = 1.0f / 60.0f;
+    // Default simulation and snapshot rates
+    static constexpr float DEFAULT_TICK_RATE = 60.0f;
+    static constexpr float DEFAULT_SEND_RATE = 60.0f;
+    // How far back lag-compensated queries can rewind, covers ~200ms round trips plus a tick of slack
+    static constexpr float LAG_COMPENSATION_MS = 250.0f;
+    // Ticks a changed scale keeps being sent for, so clients that skip ticks still see it
+    static constexpr uint64_t SCALE_RESEND_TICKS = 30;
+    // Every scale is resent on this interval as a keyframe
+    static constexpr uint64_t SCALE_KEYFRAME_TICKS = 300;
+    // Entities per world state chunk and chunks streamed per reply to a joining client
+    static constexpr size_t WORLD_CHUNK_ENTITIES = 256;
+    static constexpr size_t WORLD_CHUNKS_PER_REPLY = 4;
+    // Default snapshot bytes per client reply, unlimited so every client shares the one encoding
+    static constexpr uint32_t DEFAULT_BANDWIDTH_BUDGET = UNLIMITED_BANDWIDTH;
+    // Distance in cm at which an entity's priority is halved
+    static constexpr float PRIORITY_DISTANCE_FALLOFF = 1000.0f;
+    // Speed in cm/s that doubles an entity's priority, capped at MAX_VELOCITY_PRIORITY
+    static constexpr float PRIORITY_VELOCITY_SCALE = 500.0f;
+    static constexpr float MAX_VELOCITY_PRIORITY = 4.0f;
 };
 
 }
@@ -0,0 +1,190 @@
+#include "SessionRecording.h"
+#include <iostream>
+
+namespace SquareCore {
+
+namespace {
+
+void AppendUint(std::string& out, uint32_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) {
+        out.push_back(static_cast<char>((value >> (i * 8)) & 0xFF));
+    }
+}
+
+uint32_t ReadUint(const char* data, int bytes) {
+    uint32_t value = 0;
+    for (int i = 0; i < bytes; ++i) {
+        value |= static_cast<uint32_t>(static_cast<uint8_t>(data[i])) << (i * 8);
+    }
+    return value;
+}
+
+}
+
+SessionRecorder::~SessionRecorder() {
+    Close();
+}
+
+bool SessionRecorder::Open(const std::string& path) {
+    Close();
+
+    file.open(path, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cout << "Failed to open session recording " << path << "\n";
+        return false;
+    }
+
+    std::string header(MAGIC, sizeof(MAGIC));
+    AppendUint(header, VERSION, 2);
+    AppendUint(header, 0, 2);
+    file.write(header.data(), header.size());
+
+    bytesWritten = header.size();
+    droppedRecords = 0;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.clear();
+        queuedBytes = 0;
+        startTime = std::chrono::steady_clock::now();
+        recording = true;
+    }
+    writerThread = std::thread(&SessionRecorder::WriterThread, this);
+
+    std::cout << "Recording session to " << path << "\n";
+    return true;
+}
+
+void SessionRecorder::Close() {
+    bool wasRecording;
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        wasRecording = recording.exchange(false);
+    }
+    if (wasRecording) {
+        queueCondition.notify_all();
+    }
+    if (writerThread.joinable()) {
+        writerThread.join();
+    }
+    if (file.is_open()) {
+        file.close();
+        std::cout << "Session recording closed (" << bytesWritten.load() << " bytes, "
+                  << droppedRecords.load() << " records dropped)\n";
+    }
+}
+
+void SessionRecorder::Record(SessionRecordType type, std::string payload) {
+    if (!recording.load()) {
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        // Checked again under the lock, a record racing Close would otherwise sit in the queue after the writer
+        // stopped and end up in the next session with the old start time
+        if (!recording.load()) {
+            return;
+        }
+        uint32_t timeMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - startTime).count());
+        // A stalled disk must not grow memory without bound or hold up the caller
+        if (queuedBytes + payload.size() > MAX_QUEUED_BYTES) {
+            droppedRecords.fetch_add(1);
+            return;
+        }
+        queuedBytes += payload.size();
+        queue.push_back({ type, timeMs, std::move(payload) });
+    }
+    queueCondition.notify_one();
+}
+
+void SessionRecorder::WriterThread() {
+    std::vector<SessionRecord> batch;
+    std::string header;
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueCondition.wait(lock, [this] { return !queue.empty() || !recording.load(); });
+            if (queue.empty()) {
+                break;
+            }
+            batch.swap(queue);
+            queuedBytes = 0;
+        }
+
+        for (const SessionRecord& record : batch) {
+            header.clear();
+            AppendUint(header, static_cast<uint32_t>(record.type), 1);
+            AppendUint(header, record.timeMs, 4);
+            AppendUint(header, static_cast<uint32_t>(record.payload.size()), 4);
+            file.write(header.data(), header.size());
+            file.write(record.payload.data(), record.payload.size());
+            bytesWritten.fetch_add(header.size() + record.payload.size());
+        }
+        batch.clear();
+        file.flush();
+    }
+}
+
+bool SessionReplay::Open(const std::string& path) {
+    Close();
+
+    file.open(path, std::ios::binary);
+    if (!file.is_open()) {
+        std::cout << "Failed to open session replay " << path << "\n";
+        return false;
+    }
+
+    char header[SessionRecorder::HEADER_SIZE];
+    if (!file.read(header, sizeof(header)) ||
+        std::string(header, sizeof(SessionRecorder::MAGIC)) != std::string(SessionRecorder::MAGIC, sizeof(SessionRecorder::MAGIC))) {
+        std::cout << path << " is not a session recording\n";
+        Close();
+        return false;
+    }
+    uint32_t version = ReadUint(header + sizeof(SessionRecorder::MAGIC), 2);
+    if (version != SessionRecorder::VERSION) {
+        std::cout << "Unsupported session recording version " << version << "\n";
+        Close();
+        return false;
+    }
+
+    // Record lengths are checked against what is left of the file
+    std::streampos start = file.tellg();
+    file.seekg(0, std::ios::end);
+    fileSize = static_cast<uint64_t>(file.tellg());
+    file.seekg(start);
+    return true;
+}
+
+void SessionReplay::Close() {
+    if (file.is_open()) {
+        file.close();
+    }
+}
+
+bool SessionReplay::ReadNext(SessionRecord& record) {
+    if (!file.is_open()) {
+        return false;
+    }
+
+    char header[SessionRecorder::RECORD_HEADER_SIZE];
+    if (!file.read(header, sizeof(header))) {
+        return false;
+    }
+    record.type = static_cast<SessionRecordType>(static_cast<uint8_t>(header[0]));
+    record.timeMs = ReadUint(header + 1, 4);
+
+    uint32_t payloadSize = ReadUint(header + 5, 4);
+    uint64_t position = static_cast<uint64_t>(file.tellg());
+    if (position > fileSize || payloadSize > fileSize - position) {
+        std::cout << "Session recording record claims " << payloadSize << " bytes past the end of the file\n";
+        record.payload.clear();
+        return false;
+    }
+    record.payload.resize(payloadSize);
+    return static_cast<bool>(file.read(record.payload.data(), record.payload.size()));
+}
+
+}
@@ -0,0 +1,94 @@
+#ifndef SESSIONRECORDING_H
+#define SESSIONRECORDING_H
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace SquareCore {
+
+// Session files start with a magic and version, followed by records appended in the order they happened:
+//   uint8 type | uint32 time (ms since recording started) | uint32 payload size | payload
+// All integers are little-endian. A record cut short by a crash ends the replay at the last complete record.
+enum class SessionRecordType : uint8_t {
+    WORLD_STATE_CHUNK = 1,  // WorldStateChunk, the world as it was when recording started
+    SPAWN = 2,              // EntitySpawnInfo with its owner set
+    DESPAWN = 3,            // Entity ID as text, as in DESPAWN_ENTITY messages
+    GAME_STATE = 4,         // GameStateSnapshot of one tick
+    INPUT = 5               // InputState as received from a client
+};
+
+struct SessionRecord {
+    SessionRecordType type = SessionRecordType::GAME_STATE;
+    uint32_t timeMs = 0;
+    std::string payload;
+};
+
+// Appends records to a session file from any thread, a background writer does the disk I/O
+class SessionRecorder {
+public:
+    SessionRecorder() = default;
+    ~SessionRecorder();
+
+    bool Open(const std::string& path);
+    // Writes everything still queued and closes the file
+    void Close();
+    bool IsRecording() const { return recording.load(); }
+
+    // Queues a record stamped with the current time, never waits on the disk
+    void Record(SessionRecordType type, std::string payload);
+
+    uint64_t GetBytesWritten() const { return bytesWritten.load(); }
+    // Records dropped because the writer fell more than MAX_QUEUED_BYTES behind
+    uint64_t GetDroppedRecords() const { return droppedRecords.load(); }
+
+    static constexpr char MAGIC[4] = { 'S', 'Q', 'R', 'S' };
+    static constexpr uint16_t VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 8;
+    static constexpr size_t RECORD_HEADER_SIZE = 9;
+
+private:
+    std::ofstream file;
+    std::thread writerThread;
+    // Both change under queueMutex so a record is queued for exactly the session it was timed against
+    std::atomic<bool> recording{false};
+    std::chrono::steady_clock::time_point startTime;
+
+    // Records waiting for the writer, swapped out whole so producers only hold the lock to append
+    std::vector<SessionRecord> queue;
+    size_t queuedBytes = 0;
+    std::mutex queueMutex;
+    std::condition_variable queueCondition;
+
+    std::atomic<uint64_t> bytesWritten{0};
+    std::atomic<uint64_t> droppedRecords{0};
+
+    void WriterThread();
+
+    static constexpr size_t MAX_QUEUED_BYTES = 64 * 1024 * 1024;
+};
+
+// Reads a session file back one record at a time
+class SessionReplay {
+public:
+    bool Open(const std::string& path);
+    void Close();
+    bool IsOpen() const { return file.is_open(); }
+
+    // Reads the next record, returns false at the end of the file or on a truncated or corrupt record
+    bool ReadNext(SessionRecord& record);
+
+private:
+    std::ifstream file;
+    uint64_t fileSize = 0;
+};
+
+}
+
+#endif
@@ -1,4 +1,12 @@
 #include "Physics.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <unordered_set>
 
 namespace SquareCore 
 {
@@ -31,6 +39,10 @@ namespace SquareCore
         
         collisionMap.clear();
         shapeToEntityMap.clear();
+        bakedShapeMembers.clear();
+        bakedBodyMembers.clear();
+        rebakeMembers.clear();
+        ClearHistory();
     }
 
     void Physics::UpdateCollisions(std::vector<Entity>& entities) {
@@ -44,6 +56,7 @@ namespace SquareCore
         
         ProcessContactEvents(entities);
         ProcessSensorEvents();
+        ProcessBulletSweeps(entities);
         
         std::vector<int64_t> keysToRemove;
         for (const auto& [key, entityID] : shapeToEntityMap) {
@@ -75,7 +88,9 @@ namespace SquareCore
     void Physics::ProcessContactEvents(std::vector<Entity>& entities)
     {
         for (Entity& entity : entities) {
-            if (!entity.physicsHandle.isValid || !b2Body_IsValid(entity.physicsHandle.bodyId)) {
+            // Merged level geometry gets its records from the bodies touching it
+            if (!entity.physicsHandle.isValid || entity.physicsHandle.baked ||
+                !b2Body_IsValid(entity.physicsHandle.bodyId)) {
                 continue;
             }
 
@@ -88,44 +103,49 @@ namespace SquareCore
             for (int i = 0; i < count; ++i) {
                 const b2ContactData& contact = contacts[i];
 
-                uint32_t otherEntityId = 0;
+                b2ShapeId otherShapeId;
                 b2Vec2 normal = contact.manifold.normal;
 
-                if (GetEntityFromShape(contact.shapeIdA) == entity.ID) {
-                    otherEntityId = GetEntityFromShape(contact.shapeIdB);
+                if (B2_ID_EQUALS(b2Shape_GetBody(contact.shapeIdA), entity.physicsHandle.bodyId)) {
+                    otherShapeId = contact.shapeIdB;
                 } else {
-                    otherEntityId = GetEntityFromShape(contact.shapeIdA);
+                    otherShapeId = contact.shapeIdA;
                     normal = b2Vec2{ -normal.x, -normal.y };
                 }
 
+                b2Vec2 contactPoint = b2Body_GetPosition(entity.physicsHandle.bodyId);
+                Vec2 point = Vec2::zero();
+                if (contact.manifold.pointCount > 0) {
+                    contactPoint = contact.manifold.points[0].point;
+                    point = Vec2(ToCentimeters(contactPoint.x), ToCentimeters(contactPoint.y));
+                }
+
+                uint32_t otherEntityId = GetEntityFromShapeAt(otherShapeId, contactPoint);
                 if (otherEntityId == 0) continue;
 
-                bool alreadyRecorded = false;
-                auto it = collisionMap.find(entity.ID);
-                if (it != collisionMap.end()) {
-                    for (const auto& info : it->second) {
-                        if (info.otherEntityId == otherEntityId) {
-                            alreadyRecorded = true;
-                            break;
-                        }
-                    }
-                }
+                RecordContact(entity.ID, otherEntityId, normal, point);
 
-                if (!alreadyRecorded) {
-                    int side = ComputeCollisionSide(normal);
-                    Vec2 point = Vec2::zero();
-                    if (contact.manifold.pointCount > 0) {
-                        point = Vec2(
-                            ToCentimeters(contact.manifold.points[0].point.x),
-                            ToCentimeters(contact.manifold.points[0].point.y)
-                        );
-                    }
+                if (bakedShapeMembers.count(ShapeKey(otherShapeId)) > 0) {
+                    RecordContact(otherEntityId, entity.ID, b2Vec2{ -normal.x, -normal.y }, point);
+                }
+            }
+        }
+    }
 
-                    CollisionInfo info = { otherEntityId, side, Vec2(normal.x, normal.y), point };
-                    collisionMap[entity.ID].push_back(info);
+    void Physics::RecordContact(uint32_t entityID, uint32_t otherEntityId, b2Vec2 normal, Vec2 point)
+    {
+        auto it = collisionMap.find(entityID);
+        if (it != collisionMap.end()) {
+            for (const auto& info : it->second) {
+                if (info.otherEntityId == otherEntityId) {
+                    return;
                 }
             }
         }
+
+        int side = ComputeCollisionSide(normal);
+        CollisionInfo info = { otherEntityId, side, Vec2(normal.x, normal.y), point };
+        collisionMap[entityID].push_back(info);
     }
 
     void Physics::ProcessSensorEvents()
@@ -135,8 +155,10 @@ namespace SquareCore
         for (int i = 0; i < events.beginCount; ++i) {
             const b2SensorBeginTouchEvent& event = events.beginEvents[i];
 
-            uint32_t sensorEntity = GetEntityFromShape(event.sensorShapeId);
-            uint32_t visitorEntity = GetEntityFromShape(event.visitorShapeId);
+            b2Vec2 sensorPosition = b2Body_GetPosition(b2Shape_GetBody(event.sensorShapeId));
+            b2Vec2 visitorPosition = b2Body_GetPosition(b2Shape_GetBody(event.visitorShapeId));
+            uint32_t sensorEntity = GetEntityFromShapeAt(event.sensorShapeId, visitorPosition);
+            uint32_t visitorEntity = GetEntityFromShapeAt(event.visitorShapeId, sensorPosition);
 
             if (sensorEntity == 0 || visitorEntity == 0) continue;
 
@@ -148,6 +170,96 @@ namespace SquareCore
         }
     }
 
+    bool Physics::NeedsBulletSweep(const Entity& entity) const
+    {
+        // Dynamic solid bullets get Box2D's continuous collision, sensors and teleported bodies do not
+        return entity.isBullet && entity.physicsHandle.isValid && !entity.physicsHandle.baked &&
+               (entity.collider.type == ColliderType::TRIGGER || !entity.physApplied);
+    }
+
+    void Physics::ProcessBulletSweeps(std::vector<Entity>& entities)
+    {
+        // Shape of a bullet and the hits found along its path
+        struct SweepContext {
+            b2ShapeId self;
+            std::vector<b2ShapeId> shapes;
+            std::vector<b2Vec2> points;
+            std::vector<b2Vec2> normals;
+        };
+        SweepContext context;
+
+        for (const BulletSweep& sweep : bulletSweeps) {
+            if (sweep.entityIndex >= entities.size()) continue;
+            Entity& entity = entities[sweep.entityIndex];
+            if (!entity.physicsHandle.isValid || !b2Body_IsValid(entity.physicsHandle.bodyId) ||
+                !b2Shape_IsValid(entity.physicsHandle.shapeId)) {
+                continue;
+            }
+
+            b2Vec2 end = b2Body_GetPosition(entity.physicsHandle.bodyId);
+            b2Vec2 translation = b2Vec2{ end.x - sweep.start.p.x, end.y - sweep.start.p.y };
+            if (translation.x * translation.x + translation.y * translation.y < 1e-8f) continue;
+
+            b2ShapeId shapeId = entity.physicsHandle.shapeId;
+            b2ShapeProxy proxy;
+            switch (b2Shape_GetType(shapeId))
+            {
+            case b2_circleShape:
+                {
+                    b2Circle circle = b2Shape_GetCircle(shapeId);
+                    proxy = b2MakeOffsetProxy(&circle.center, 1, circle.radius, sweep.start.p, sweep.start.q);
+                    break;
+                }
+            case b2_capsuleShape:
+                {
+                    b2Capsule capsule = b2Shape_GetCapsule(shapeId);
+                    b2Vec2 points[2] = { capsule.center1, capsule.center2 };
+                    proxy = b2MakeOffsetProxy(points, 2, capsule.radius, sweep.start.p, sweep.start.q);
+                    break;
+                }
+            case b2_polygonShape:
+                {
+                    b2Polygon polygon = b2Shape_GetPolygon(shapeId);
+                    proxy = b2MakeOffsetProxy(polygon.vertices, polygon.count, polygon.radius, sweep.start.p, sweep.start.q);
+                    break;
+                }
+            default:
+                continue;
+            }
+
+            context.self = shapeId;
+            context.shapes.clear();
+            context.points.clear();
+            context.normals.clear();
+            b2World_CastShape(worldId, &proxy, translation, b2DefaultQueryFilter(),
+                [](b2ShapeId hitShape, b2Vec2 point, b2Vec2 normal, float fraction, void* userContext) -> float {
+                    (void)fraction;
+                    SweepContext* sweepContext = static_cast<SweepContext*>(userContext);
+                    if (B2_ID_EQUALS(hitShape, sweepContext->self) || b2Shape_IsSensor(hitShape)) {
+                        return -1.0f;
+                    }
+                    sweepContext->shapes.push_back(hitShape);
+                    sweepContext->points.push_back(point);
+                    sweepContext->normals.push_back(normal);
+                    // Keep the full path so everything the bullet passed through is reported
+                    return 1.0f;
+                }, &context);
+
+            for (size_t i = 0; i < context.shapes.size(); ++i) {
+                uint32_t otherEntityId = GetEntityFromShapeAt(context.shapes[i], context.points[i]);
+                if (otherEntityId == 0 || otherEntityId == entity.ID) continue;
+
+                // Cast normals point back at the bullet, contact normals point at the other entity
+                b2Vec2 normal = b2Vec2{ -context.normals[i].x, -context.normals[i].y };
+                Vec2 centimeterPoint(ToCentimeters(context.points[i].x), ToCentimeters(context.points[i].y));
+                RecordContact(entity.ID, otherEntityId, normal, centimeterPoint);
+                RecordContact(otherEntityId, entity.ID, b2Vec2{ -normal.x, -normal.y }, centimeterPoint);
+            }
+        }
+
+        bulletSweeps.clear();
+    }
+
     int Physics::ComputeCollisionSide(const b2Vec2& normal) const
     {
         if (std::abs(normal.y) > std::abs(normal.x))
@@ -162,13 +274,45 @@ namespace SquareCore
 
     uint32_t Physics::GetEntityFromShape(b2ShapeId shapeId) const
     {
-        int64_t key = (static_cast<int64_t>(shapeId.index1) << 32) | shapeId.generation;
-        auto it = shapeToEntityMap.find(key);
+        auto it = shapeToEntityMap.find(ShapeKey(shapeId));
         if (it != shapeToEntityMap.end())
             return it->second;
         return 0;
     }
 
+    uint32_t Physics::GetEntityFromShapeAt(b2ShapeId shapeId, b2Vec2 point)
+    {
+        auto baked = bakedShapeMembers.find(ShapeKey(shapeId));
+        if (baked == bakedShapeMembers.end() || baked->second.empty()) {
+            return GetEntityFromShape(shapeId);
+        }
+
+        // Resolve a merged shape to the member whose original box is closest to the point
+        Vec2 p(ToCentimeters(point.x), ToCentimeters(point.y));
+        uint32_t closestEntity = baked->second.front().entityID;
+        float closestDistance = -1.0f;
+        for (const BakedMember& member : baked->second) {
+            float dx = Max(Max(member.min.x - p.x, 0.0f), p.x - member.max.x);
+            float dy = Max(Max(member.min.y - p.y, 0.0f), p.y - member.max.y);
+            float distance = dx * dx + dy * dy;
+            if (closestDistance < 0.0f || distance < closestDistance) {
+                closestDistance = distance;
+                closestEntity = member.entityID;
+            }
+        }
+        return closestEntity;
+    }
+
+    int64_t Physics::ShapeKey(b2ShapeId shapeId)
+    {
+        return (static_cast<int64_t>(shapeId.index1) << 32) | shapeId.generation;
+    }
+
+    int64_t Physics::BodyKey(b2BodyId bodyId)
+    {
+        return (static_cast<int64_t>(bodyId.index1) << 32) | bodyId.generation;
+    }
+
     void Physics::Update(float fixedDeltaTime)
     {
         if (!entityManagerRef) return;
@@ -176,9 +320,31 @@ namespace SquareCore
         std::lock_guard<std::mutex> lock(entityManagerRef->GetMutex());
         std::vector<Entity>& entities = entityManagerRef->GetEntitiesUnsafe();
         
+        // Phase timings are only sampled while profiling is enabled
+        lastStepProfile = PhysicsStepProfile();
+        std::chrono::steady_clock::time_point phaseStart;
+        if (profilingEnabled) phaseStart = std::chrono::steady_clock::now();
+        auto endPhase = [this, &phaseStart](float& phaseMs) {
+            if (!profilingEnabled) return;
+            std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+            phaseMs += std::chrono::duration<float, std::milli>(now - phaseStart).count();
+            phaseStart = now;
+        };
+        
+        if (staticBakePending) {
+            BakeStaticGeometry(entities);
+            staticBakePending = false;
+            rebakeMembers.clear();
+        } else if (!rebakeMembers.empty()) {
+            std::unordered_set<uint32_t> members = std::move(rebakeMembers);
+            rebakeMembers.clear();
+            BakeStaticGeometry(entities, &members);
+        }
+        
         for (Entity& entity : entities) {
             if (entity.collider.type != ColliderType::NONE && entity.collider.enabled && entity.visible) {
-                if (!entity.physicsHandle.isValid) {
+                // Bodies wait until the sprite has loaded since its size drives the collider
+                if (!entity.physicsHandle.isValid && !entity.texturePending) {
                     CreateBodyInternal(entity);
                 }
             }
@@ -186,23 +352,43 @@ namespace SquareCore
                 DestroyBodyInternal(entity);
             }
         }
+        endPhase(lastStepProfile.lifecycleMs);
         
-        for (Entity& entity : entities) {
-            if (entity.physicsHandle.isValid && !entity.physApplied) {
+        bulletSweeps.clear();
+        for (size_t i = 0; i < entities.size(); ++i) {
+            Entity& entity = entities[i];
+            if (NeedsBulletSweep(entity) && b2Body_IsValid(entity.physicsHandle.bodyId)) {
+                bulletSweeps.push_back({ i, b2Body_GetTransform(entity.physicsHandle.bodyId) });
+            }
+            if (entity.physicsHandle.isValid && !entity.physApplied && !entity.physicsHandle.baked) {
                 SyncBodyToEntity(entity);
             }
         }
+        endPhase(lastStepProfile.syncMs);
         
         int subStepCount = 4;
         b2World_Step(worldId, fixedDeltaTime, subStepCount);
+        endPhase(lastStepProfile.stepMs);
         
-        for (Entity& entity : entities) {
-            if (entity.physicsHandle.isValid && entity.physApplied) {
-                SyncEntityToBody(entity);
+        // Only bodies that moved this step report a move event, resting bodies keep their last synced state
+        b2BodyEvents bodyEvents = b2World_GetBodyEvents(worldId);
+        for (int i = 0; i < bodyEvents.moveCount; ++i) {
+            const b2BodyMoveEvent& event = bodyEvents.moveEvents[i];
+            uint32_t entityID = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(event.userData));
+            Entity* entity = entityManagerRef->GetEntityByIDUnsafe(entityID);
+            if (!entity || !entity->physicsHandle.isValid || !B2_ID_EQUALS(entity->physicsHandle.bodyId, event.bodyId)) {
+                continue;
+            }
+            
+            entity->physicsHandle.sleeping = event.fellAsleep;
+            if (entity->physApplied) {
+                SyncEntityToBody(*entity, event.transform);
             }
         }
+        endPhase(lastStepProfile.syncMs);
         
         UpdateCollisions(entities);
+        endPhase(lastStepProfile.collisionMs);
     }
 
     b2ShapeId Physics::CreateShapeForBody(b2BodyId bodyId, const Entity& entity)
@@ -261,10 +447,10 @@ namespace SquareCore
             }
         case ColliderShape::POLYGON:
             {
-                if (entity.shapeData.polygon.vertices.size() >= 3)
+                if (entity.shapeData.polygon.vertices && entity.shapeData.polygon.vertices->size() >= 3)
                 {
                     std::vector<b2Vec2> verts(4);
-                    for (const auto& v : entity.shapeData.polygon.vertices)
+                    for (const auto& v : *entity.shapeData.polygon.vertices)
                     {
                         verts.push_back(b2Vec2{ToMeters(v.x), ToMeters(v.y)});
                     }
@@ -277,18 +463,7 @@ namespace SquareCore
         case ColliderShape::BOX:
         default:
             {
-                Vec2 halfExtents = entity.shapeData.box.halfExtents;
-                if (halfExtents.x <= 0 || halfExtents.y <= 0) {
-                    if (entity.isSpriteless) {
-                        halfExtents.x = (entity.spritelessWidth * std::abs(entity.scale.x)) / 2.0f;
-                        halfExtents.y = (entity.spritelessHeight * std::abs(entity.scale.y)) / 2.0f;
-                    } else {
-                        float frameWidth = entity.totalFrames > 1 ?
-                                               (entity.spriteWidth / static_cast<float>(entity.totalFrames)) : entity.spriteWidth;
-                        halfExtents.x = (frameWidth * std::abs(entity.scale.x)) / 2.0f;
-                        halfExtents.y = (entity.spriteHeight * std::abs(entity.scale.y)) / 2.0f;
-                    }
-                }
+                Vec2 halfExtents = ComputeBoxHalfExtents(entity);
 
                 b2Polygon box = b2MakeOffsetBox(
                     ToMeters(halfExtents.x),
@@ -308,16 +483,244 @@ namespace SquareCore
         return shapeId;
     }
 
+    Vec2 Physics::ComputeBoxHalfExtents(const Entity& entity) const
+    {
+        Vec2 halfExtents = entity.shapeData.box.halfExtents;
+        if (halfExtents.x <= 0 || halfExtents.y <= 0) {
+            if (entity.isSpriteless) {
+                halfExtents.x = (entity.spritelessWidth * std::abs(entity.scale.x)) / 2.0f;
+                halfExtents.y = (entity.spritelessHeight * std::abs(entity.scale.y)) / 2.0f;
+            } else {
+                float frameWidth = entity.totalFrames > 1 ?
+                                       (entity.spriteWidth / static_cast<float>(entity.totalFrames)) : entity.spriteWidth;
+                halfExtents.x = (frameWidth * std::abs(entity.scale.x)) / 2.0f;
+                halfExtents.y = (entity.spriteHeight * std::abs(entity.scale.y)) / 2.0f;
+            }
+        }
+        return halfExtents;
+    }
+
     void Physics::RegisterShape(b2ShapeId shapeId, uint32_t entityID)
     {
-        int64_t key = (static_cast<int64_t>(shapeId.index1) << 32) | shapeId.generation;
-        shapeToEntityMap[key] = entityID;
+        shapeToEntityMap[ShapeKey(shapeId)] = entityID;
     }
 
     void Physics::UnregisterShape(b2ShapeId shapeId)
     {
-        int64_t key = (static_cast<int64_t>(shapeId.index1) << 32) | shapeId.generation;
-        shapeToEntityMap.erase(key);
+        shapeToEntityMap.erase(ShapeKey(shapeId));
+    }
+
+    bool Physics::IsStaticBakeCandidate(const Entity& entity) const
+    {
+        return !entity.physApplied && !entity.persistent && entity.visible &&
+               entity.collider.enabled && entity.collider.type == ColliderType::SOLID &&
+               entity.shapeData.shape == ColliderShape::BOX &&
+               CompareFloats(entity.rotation, 0.0f) && !entity.isBullet && !entity.physicsHandle.baked;
+    }
+
+    void Physics::BakeStaticGeometry(std::vector<Entity>& entities, const std::unordered_set<uint32_t>* onlyIDs)
+    {
+        // Rectangle of merged level geometry, in centimeters
+        struct BakeRect {
+            Vec2 min;
+            Vec2 max;
+            std::vector<BakedMember> members;
+        };
+        const float epsilon = 0.5f;
+
+        // Group candidates by their tag set so collision reports stay meaningful per group
+        std::unordered_map<std::string, std::vector<BakeRect>> groups;
+        for (Entity& entity : entities) {
+            if (!IsStaticBakeCandidate(entity)) continue;
+            if (onlyIDs && onlyIDs->count(entity.ID) == 0) continue;
+
+            std::vector<std::string> sortedTags = entity.GetAllTags();
+            std::sort(sortedTags.begin(), sortedTags.end());
+            std::string key;
+            for (const std::string& tag : sortedTags) {
+                key += tag;
+                key += '\n';
+            }
+
+            Vec2 half = ComputeBoxHalfExtents(entity);
+            if (half.x <= 0.0f || half.y <= 0.0f) continue;
+            Vec2 center = entity.position + entity.collider.offset;
+
+            BakeRect rect;
+            rect.min = center - half;
+            rect.max = center + half;
+            rect.members.push_back({ entity.ID, rect.min, rect.max });
+            groups[key].push_back(std::move(rect));
+        }
+
+        std::unordered_map<uint32_t, Entity*> entityLookup;
+        for (Entity& entity : entities) {
+            entityLookup[entity.ID] = &entity;
+        }
+
+        for (auto& [key, rects] : groups) {
+            if (rects.size() < 2) continue;
+
+            // Merge boxes whose union is exactly a rectangle, which removes the seams between them. Runs within
+            // each row are merged first, then runs of the resulting strips within each column; sorting groups a
+            // row (or column) together and orders it along the run, so each pass is one sweep
+            auto mergeRuns = [&rects, epsilon](bool alongX) {
+                auto lo = [alongX](const Vec2& v) { return alongX ? v.x : v.y; };
+                auto across = [alongX](const Vec2& v) { return alongX ? v.y : v.x; };
+                auto band = [epsilon](float value) { return static_cast<int64_t>(std::llround(value / epsilon)); };
+
+                std::sort(rects.begin(), rects.end(), [&](const BakeRect& a, const BakeRect& b) {
+                    int64_t aMin = band(across(a.min)), bMin = band(across(b.min));
+                    if (aMin != bMin) return aMin < bMin;
+                    int64_t aMax = band(across(a.max)), bMax = band(across(b.max));
+                    if (aMax != bMax) return aMax < bMax;
+                    return lo(a.min) < lo(b.min);
+                });
+
+                size_t kept = 0;
+                for (size_t i = 0; i < rects.size(); ++i) {
+                    if (kept > 0) {
+                        BakeRect& run = rects[kept - 1];
+                        BakeRect& next = rects[i];
+                        bool sameBand = CompareFloats(across(run.min), across(next.min), epsilon) &&
+                                        CompareFloats(across(run.max), across(next.max), epsilon);
+                        if (sameBand && lo(next.min) <= lo(run.max) + epsilon) {
+                            run.min = Vec2(Min(run.min.x, next.min.x), Min(run.min.y, next.min.y));
+                            run.max = Vec2(Max(run.max.x, next.max.x), Max(run.max.y, next.max.y));
+                            run.members.insert(run.members.end(), std::make_move_iterator(next.members.begin()),
+                                               std::make_move_iterator(next.members.end()));
+                            continue;
+                        }
+                    }
+                    if (kept != i) {
+                        rects[kept] = std::move(rects[i]);
+                    }
+                    ++kept;
+                }
+                rects.resize(kept);
+            };
+            mergeRuns(true);
+            mergeRuns(false);
+
+            // Cluster touching rectangles so each connected piece of geometry shares one body, sweeping along x
+            // and only testing rectangles whose x range is still open
+            std::vector<size_t> parent(rects.size());
+            std::iota(parent.begin(), parent.end(), 0);
+            auto findRoot = [&parent](size_t i) {
+                while (parent[i] != i) {
+                    parent[i] = parent[parent[i]];
+                    i = parent[i];
+                }
+                return i;
+            };
+            std::sort(rects.begin(), rects.end(), [](const BakeRect& a, const BakeRect& b) { return a.min.x < b.min.x; });
+            std::vector<size_t> open;
+            for (size_t i = 0; i < rects.size(); ++i) {
+                const BakeRect& a = rects[i];
+                for (size_t k = 0; k < open.size();) {
+                    const BakeRect& b = rects[open[k]];
+                    if (b.max.x + epsilon < a.min.x) {
+                        open[k] = open.back();
+                        open.pop_back();
+                        continue;
+                    }
+                    if (a.min.y <= b.max.y + epsilon && b.min.y <= a.max.y + epsilon) {
+                        parent[findRoot(i)] = findRoot(open[k]);
+                    }
+                    ++k;
+                }
+                open.push_back(i);
+            }
+
+            std::unordered_map<size_t, std::vector<size_t>> clusters;
+            for (size_t i = 0; i < rects.size(); ++i) {
+                clusters[findRoot(i)].push_back(i);
+            }
+
+            for (const auto& [root, indices] : clusters) {
+                if (indices.size() == 1 && rects[indices[0]].members.size() == 1) continue;
+
+                b2BodyDef bodyDef = b2DefaultBodyDef();
+                bodyDef.type = b2_staticBody;
+                b2BodyId bodyId = b2CreateBody(worldId, &bodyDef);
+
+                b2ShapeDef shapeDef = b2DefaultShapeDef();
+                shapeDef.material.friction = 0.3f;
+                shapeDef.material.restitution = 0.0f;
+                shapeDef.enableContactEvents = true;
+                shapeDef.enableSensorEvents = true;
+
+                std::vector<uint32_t>& bodyMembers = bakedBodyMembers[BodyKey(bodyId)];
+                for (size_t index : indices) {
+                    const BakeRect& rect = rects[index];
+                    Vec2 half = (rect.max - rect.min) * 0.5f;
+                    Vec2 center = (rect.max + rect.min) * 0.5f;
+
+                    b2Polygon box = b2MakeOffsetBox(ToMeters(half.x), ToMeters(half.y),
+                                                    b2Vec2{ ToMeters(center.x), ToMeters(center.y) }, b2MakeRot(0.0f));
+                    b2ShapeId shapeId = b2CreatePolygonShape(bodyId, &shapeDef, &box);
+
+                    // Merged shapes aren't registered to one entity, lookups resolve them through their members
+                    bakedShapeMembers[ShapeKey(shapeId)] = rect.members;
+
+                    for (const BakedMember& member : rect.members) {
+                        auto it = entityLookup.find(member.entityID);
+                        if (it == entityLookup.end()) continue;
+
+                        Entity& entity = *it->second;
+                        if (entity.physicsHandle.isValid) {
+                            DestroyBodyInternal(entity);
+                        }
+                        entity.physicsHandle.bodyId = bodyId;
+                        entity.physicsHandle.shapeId = shapeId;
+                        entity.physicsHandle.isValid = true;
+                        entity.physicsHandle.baked = true;
+                        bodyMembers.push_back(member.entityID);
+                    }
+                }
+            }
+        }
+    }
+
+    void Physics::UnbakeBody(b2BodyId bodyId, uint32_t removedEntityID)
+    {
+        auto membersIt = bakedBodyMembers.find(BodyKey(bodyId));
+        if (membersIt == bakedBodyMembers.end()) return;
+
+        std::vector<uint32_t> members = std::move(membersIt->second);
+        bakedBodyMembers.erase(membersIt);
+
+        if (b2Body_IsValid(bodyId)) {
+            int shapeCount = b2Body_GetShapeCount(bodyId);
+            std::vector<b2ShapeId> shapes(shapeCount);
+            shapeCount = b2Body_GetShapes(bodyId, shapes.data(), shapeCount);
+            for (int i = 0; i < shapeCount; ++i) {
+                UnregisterShape(shapes[i]);
+                bakedShapeMembers.erase(ShapeKey(shapes[i]));
+            }
+            b2DestroyBody(bodyId);
+        }
+
+        // The rest of the piece is merged again on the next step so its seams don't come back, members that
+        // can't be merged fall back to individual bodies
+        if (removedEntityID != 0) {
+            for (uint32_t memberID : members) {
+                if (memberID != removedEntityID) {
+                    rebakeMembers.insert(memberID);
+                }
+            }
+        }
+        if (!entityManagerRef) return;
+        std::vector<Entity>& entities = entityManagerRef->GetEntitiesUnsafe();
+        std::unordered_set<uint32_t> memberSet(members.begin(), members.end());
+        for (Entity& entity : entities) {
+            if (entity.physicsHandle.baked && memberSet.count(entity.ID) > 0) {
+                entity.physicsHandle.bodyId = b2_nullBodyId;
+                entity.physicsHandle.shapeId = b2_nullShapeId;
+                entity.physicsHandle.isValid = false;
+                entity.physicsHandle.baked = false;
+            }
+        }
     }
 
     void Physics::SetGravity(float gravity)
@@ -364,9 +767,12 @@ namespace SquareCore
         bodyDef.linearVelocity = {ToMeters(entity.velocity.x), ToMeters(entity.velocity.y)};
         bodyDef.linearDamping = entity.drag;
         bodyDef.motionLocks.angularZ = entity.fixedRotation;
+        bodyDef.isBullet = entity.isBullet;
+        bodyDef.userData = reinterpret_cast<void*>(static_cast<uintptr_t>(entity.ID));
 
         entity.physicsHandle.bodyId = b2CreateBody(worldId, &bodyDef);
         entity.physicsHandle.isValid = true;
+        entity.physicsHandle.sleeping = false;
         entity.physicsHandle.shapeId = CreateShapeForBody(entity.physicsHandle.bodyId, entity);
         
         if (b2Body_IsValid(entity.physicsHandle.bodyId))
@@ -392,10 +798,26 @@ namespace SquareCore
         if (entity) DestroyBodyInternal(*entity);
     }
     
+    void Physics::DestroyBodiesUnsafe(const std::unordered_set<uint32_t>& entityIDs)
+    {
+        if (!entityManagerRef || entityIDs.empty()) return;
+
+        for (Entity& entity : entityManagerRef->GetEntitiesUnsafe()) {
+            if (entity.physicsHandle.isValid && entityIDs.count(entity.ID) > 0) {
+                DestroyBodyInternal(entity);
+            }
+        }
+    }
+
     void Physics::DestroyBodyInternal(Entity& entity)
     {
         if (!entity.physicsHandle.isValid) return;
 
+        if (entity.physicsHandle.baked) {
+            UnbakeBody(entity.physicsHandle.bodyId, entity.ID);
+            return;
+        }
+
         if (b2Shape_IsValid(entity.physicsHandle.shapeId)) {
             UnregisterShape(entity.physicsHandle.shapeId);
         }
@@ -417,6 +839,12 @@ namespace SquareCore
         
         for (Entity& entity : entities)
         {
+            if (entity.physicsHandle.baked)
+            {
+                UnbakeBody(entity.physicsHandle.bodyId);
+                continue;
+            }
+            
             if (!entity.persistent && entity.physicsHandle.isValid)
             {
                 if (b2Shape_IsValid(entity.physicsHandle.shapeId))
@@ -433,6 +861,285 @@ namespace SquareCore
                 entity.physicsHandle.isValid = false;
             }
         }
+        
+        // Recorded bounds belong to the scene being cleared
+        ClearHistory();
+    }
+
+    // Fixed-size record written per entity into a PhysicsSnapshot buffer
+    struct EntitySnapshotRecord
+    {
+        uint32_t entityID;
+        uint8_t flags;
+        int32_t currentFrame;
+        float elapsedTime;
+        Vec2 position;
+        float rotation;
+        Vec2 scale;
+        Vec2 velocity;
+        Vec2 acceleration;
+        b2Vec2 bodyPosition;
+        b2Rot bodyRotation;
+        b2Vec2 bodyLinearVelocity;
+        float bodyAngularVelocity;
+    };
+
+    enum EntitySnapshotFlags : uint8_t
+    {
+        SNAPSHOT_VISIBLE = 1 << 0,
+        SNAPSHOT_FLIP_X = 1 << 1,
+        SNAPSHOT_FLIP_Y = 1 << 2,
+        SNAPSHOT_COLLIDER_ENABLED = 1 << 3,
+        SNAPSHOT_HAS_BODY = 1 << 4,
+        SNAPSHOT_AWAKE = 1 << 5,
+    };
+
+    void Physics::SaveSnapshot(PhysicsSnapshot& snapshot)
+    {
+        snapshot.buffer.clear();
+        snapshot.entityCount = 0;
+        if (!entityManagerRef) return;
+        std::lock_guard<std::mutex> lock(entityManagerRef->GetMutex());
+
+        std::vector<Entity>& entities = entityManagerRef->GetEntitiesUnsafe();
+        snapshot.buffer.resize(entities.size() * sizeof(EntitySnapshotRecord));
+
+        uint8_t* out = snapshot.buffer.data();
+        for (const Entity& entity : entities) {
+            EntitySnapshotRecord record = {};
+            record.entityID = entity.ID;
+            record.currentFrame = entity.currentFrame;
+            record.elapsedTime = entity.elapsedTime;
+            record.position = entity.position;
+            record.rotation = entity.rotation;
+            record.scale = entity.scale;
+            record.velocity = entity.velocity;
+            record.acceleration = entity.acceleration;
+
+            if (entity.visible) record.flags |= SNAPSHOT_VISIBLE;
+            if (entity.flipX) record.flags |= SNAPSHOT_FLIP_X;
+            if (entity.flipY) record.flags |= SNAPSHOT_FLIP_Y;
+            if (entity.collider.enabled) record.flags |= SNAPSHOT_COLLIDER_ENABLED;
+
+            // Baked level geometry is static, so only individually owned bodies carry solver state
+            const PhysicsHandle& handle = entity.physicsHandle;
+            if (handle.isValid && !handle.baked && b2Body_IsValid(handle.bodyId)) {
+                record.flags |= SNAPSHOT_HAS_BODY;
+                if (b2Body_IsAwake(handle.bodyId)) record.flags |= SNAPSHOT_AWAKE;
+                record.bodyPosition = b2Body_GetPosition(handle.bodyId);
+                record.bodyRotation = b2Body_GetRotation(handle.bodyId);
+                record.bodyLinearVelocity = b2Body_GetLinearVelocity(handle.bodyId);
+                record.bodyAngularVelocity = b2Body_GetAngularVelocity(handle.bodyId);
+            }
+
+            std::memcpy(out, &record, sizeof(record));
+            out += sizeof(record);
+        }
+        snapshot.entityCount = static_cast<uint32_t>(entities.size());
+    }
+
+    bool Physics::RestoreSnapshot(const PhysicsSnapshot& snapshot)
+    {
+        if (!entityManagerRef) return false;
+        if (snapshot.buffer.size() != snapshot.entityCount * sizeof(EntitySnapshotRecord)) {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "RestoreSnapshot: Snapshot buffer is corrupt");
+            return false;
+        }
+        std::lock_guard<std::mutex> lock(entityManagerRef->GetMutex());
+
+        std::vector<Entity>& entities = entityManagerRef->GetEntitiesUnsafe();
+        std::unordered_map<uint32_t, Entity*> entityLookup;
+
+        const uint8_t* in = snapshot.buffer.data();
+        for (uint32_t i = 0; i < snapshot.entityCount; ++i) {
+            EntitySnapshotRecord record;
+            std::memcpy(&record, in, sizeof(record));
+            in += sizeof(record);
+
+            // Entity order is stable between captures, so only fall back to a lookup after removals
+            Entity* entity = nullptr;
+            if (i < entities.size() && entities[i].ID == record.entityID) {
+                entity = &entities[i];
+            } else {
+                if (entityLookup.empty()) {
+                    for (Entity& e : entities) {
+                        entityLookup[e.ID] = &e;
+                    }
+                }
+                auto it = entityLookup.find(record.entityID);
+                if (it == entityLookup.end()) continue;
+                entity = it->second;
+            }
+
+            entity->currentFrame = record.currentFrame;
+            entity->elapsedTime = record.elapsedTime;
+            entity->position = record.position;
+            entity->rotation = record.rotation;
+            entity->scale = record.scale;
+            entity->velocity = record.velocity;
+            entity->acceleration = record.acceleration;
+            entity->visible = (record.flags & SNAPSHOT_VISIBLE) != 0;
+            entity->flipX = (record.flags & SNAPSHOT_FLIP_X) != 0;
+            entity->flipY = (record.flags & SNAPSHOT_FLIP_Y) != 0;
+            entity->collider.enabled = (record.flags & SNAPSHOT_COLLIDER_ENABLED) != 0;
+            entityManagerRef->UpdateSpatialUnsafe(*entity);
+
+            // Bodies that don't exist yet are created from the restored entity state on the next step
+            PhysicsHandle& handle = entity->physicsHandle;
+            if ((record.flags & SNAPSHOT_HAS_BODY) && handle.isValid && !handle.baked && b2Body_IsValid(handle.bodyId)) {
+                b2Body_SetTransform(handle.bodyId, record.bodyPosition, record.bodyRotation);
+                b2Body_SetLinearVelocity(handle.bodyId, record.bodyLinearVelocity);
+                b2Body_SetAngularVelocity(handle.bodyId, record.bodyAngularVelocity);
+                b2Body_SetAwake(handle.bodyId, (record.flags & SNAPSHOT_AWAKE) != 0);
+                handle.sleeping = (record.flags & SNAPSHOT_AWAKE) == 0;
+            }
+        }
+
+        collisionMap.clear();
+        return true;
+    }
+
+    void Physics::SetHistoryCapacity(size_t frameCount)
+    {
+        historyFrames.clear();
+        historyFrames.resize(frameCount);
+        historyHead = 0;
+        historyCount = 0;
+    }
+
+    void Physics::ClearHistory()
+    {
+        historyHead = 0;
+        historyCount = 0;
+    }
+
+    void Physics::RecordHistory(uint64_t timestamp)
+    {
+        if (historyFrames.empty() || !entityManagerRef) return;
+        
+        HistoryFrame& frame = historyFrames[historyHead];
+        frame.timestamp = timestamp;
+        frame.records.clear();
+        {
+            std::lock_guard<std::mutex> lock(entityManagerRef->GetMutex());
+            const std::vector<Entity>& entities = entityManagerRef->GetEntitiesUnsafe();
+            
+            // Baked level geometry never moves, everything else may have been moved by physics or scripts
+            for (const Entity& entity : entities) {
+                const PhysicsHandle& handle = entity.physicsHandle;
+                if (!entity.collider.enabled || !handle.isValid || handle.baked || !b2Body_IsValid(handle.bodyId)) {
+                    continue;
+                }
+                b2AABB bounds = b2Body_ComputeAABB(handle.bodyId);
+                HistoryRecord record;
+                record.entityID = entity.ID;
+                record.position = entity.position;
+                record.min = Vec2(ToCentimeters(bounds.lowerBound.x), ToCentimeters(bounds.lowerBound.y));
+                record.max = Vec2(ToCentimeters(bounds.upperBound.x), ToCentimeters(bounds.upperBound.y));
+                frame.records.push_back(record);
+            }
+        }
+        std::sort(frame.records.begin(), frame.records.end(),
+                  [](const HistoryRecord& a, const HistoryRecord& b) { return a.entityID < b.entityID; });
+        
+        historyHead = (historyHead + 1) % historyFrames.size();
+        historyCount = std::min(historyCount + 1, historyFrames.size());
+    }
+
+    bool Physics::FindHistoryFrames(uint64_t timestamp, const HistoryFrame*& older, const HistoryFrame*& newer, float& alpha) const
+    {
+        if (historyCount == 0) return false;
+        
+        size_t capacity = historyFrames.size();
+        const HistoryFrame* newest = &historyFrames[(historyHead + capacity - 1) % capacity];
+        const HistoryFrame* oldest = &historyFrames[(historyHead + capacity - historyCount) % capacity];
+        older = newer = newest;
+        alpha = 0.0f;
+        if (timestamp >= newest->timestamp) return true;
+        if (timestamp <= oldest->timestamp) {
+            older = newer = oldest;
+            return true;
+        }
+        
+        // Walk back from the newest frame until the requested time is bracketed
+        for (size_t i = 1; i < historyCount; ++i) {
+            const HistoryFrame* frame = &historyFrames[(historyHead + capacity - 1 - i) % capacity];
+            if (frame->timestamp <= timestamp) {
+                older = frame;
+                uint64_t span = newer->timestamp - older->timestamp;
+                alpha = span > 0 ? static_cast<float>(timestamp - older->timestamp) / static_cast<float>(span) : 0.0f;
+                return true;
+            }
+            newer = frame;
+        }
+        older = newer;
+        return true;
+    }
+
+    const Physics::HistoryRecord* Physics::FindHistoryRecord(const HistoryFrame& frame, uint32_t entityID)
+    {
+        auto it = std::lower_bound(frame.records.begin(), frame.records.end(), entityID,
+                                   [](const HistoryRecord& record, uint32_t id) { return record.entityID < id; });
+        if (it == frame.records.end() || it->entityID != entityID) return nullptr;
+        return &*it;
+    }
+
+    std::vector<uint32_t> Physics::OverlapBoxAt(uint64_t timestamp, Vec2 center, Vec2 halfExtents, uint32_t ignoreEntityID) const
+    {
+        std::vector<uint32_t> hits;
+        const HistoryFrame* older = nullptr;
+        const HistoryFrame* newer = nullptr;
+        float alpha = 0.0f;
+        if (!FindHistoryFrames(timestamp, older, newer, alpha)) return hits;
+        
+        Vec2 queryMin = center - halfExtents;
+        Vec2 queryMax = center + halfExtents;
+        auto overlaps = [&](const Vec2& min, const Vec2& max) {
+            return min.x <= queryMax.x && max.x >= queryMin.x && min.y <= queryMax.y && max.y >= queryMin.y;
+        };
+        
+        for (const HistoryRecord& record : older->records) {
+            if (record.entityID == ignoreEntityID) continue;
+            Vec2 min = record.min;
+            Vec2 max = record.max;
+            if (newer != older) {
+                // Entities that despawned in between are tested at their last recorded bounds
+                if (const HistoryRecord* next = FindHistoryRecord(*newer, record.entityID)) {
+                    min = min + (next->min - min) * alpha;
+                    max = max + (next->max - max) * alpha;
+                }
+            }
+            if (overlaps(min, max)) {
+                hits.push_back(record.entityID);
+            }
+        }
+        
+        // Entities that spawned between the two frames only exist in the newer one
+        if (newer != older) {
+            for (const HistoryRecord& record : newer->records) {
+                if (record.entityID == ignoreEntityID || FindHistoryRecord(*older, record.entityID)) continue;
+                if (overlaps(record.min, record.max)) {
+                    hits.push_back(record.entityID);
+                }
+            }
+        }
+        return hits;
+    }
+
+    bool Physics::GetPositionAt(uint32_t entityID, uint64_t timestamp, Vec2& position) const
+    {
+        const HistoryFrame* older = nullptr;
+        const HistoryFrame* newer = nullptr;
+        float alpha = 0.0f;
+        if (!FindHistoryFrames(timestamp, older, newer, alpha)) return false;
+        
+        const HistoryRecord* from = FindHistoryRecord(*older, entityID);
+        const HistoryRecord* to = FindHistoryRecord(*newer, entityID);
+        if (!from && !to) return false;
+        if (!from) from = to;
+        if (!to) to = from;
+        position = from->position + (to->position - from->position) * alpha;
+        return true;
     }
 
     void Physics::SyncBodyToEntity(Entity& entity)
@@ -447,20 +1154,20 @@ namespace SquareCore
         b2Body_SetLinearVelocity(entity.physicsHandle.bodyId, vel);
     }
 
-    void Physics::SyncEntityToBody(Entity& entity)
+    void Physics::SyncEntityToBody(Entity& entity, const b2Transform& transform)
     {
         if (!entity.physicsHandle.isValid || !b2Body_IsValid(entity.physicsHandle.bodyId)) return;
         
-        b2Vec2 pos = b2Body_GetPosition(entity.physicsHandle.bodyId);
-        entity.position.x = ToCentimeters(pos.x);
-        entity.position.y = ToCentimeters(pos.y);
+        entity.position.x = ToCentimeters(transform.p.x);
+        entity.position.y = ToCentimeters(transform.p.y);
         
-        b2Rot rot = b2Body_GetRotation(entity.physicsHandle.bodyId);
-        entity.rotation = -b2Rot_GetAngle(rot) * 180.0f / MATH_PI;
+        entity.rotation = -b2Rot_GetAngle(transform.q) * 180.0f / MATH_PI;
         
         b2Vec2 vel = b2Body_GetLinearVelocity(entity.physicsHandle.bodyId);
         entity.velocity.x = ToCentimeters(vel.x);
         entity.velocity.y = ToCentimeters(vel.y);
+
+        if (entityManagerRef) entityManagerRef->UpdateSpatialUnsafe(entity);
     }
 
     void Physics::SetColliderShape(uint32_t entityID, const ColliderShapeData& shapeData)
@@ -479,6 +1186,11 @@ namespace SquareCore
         
         if (!entity) return;
 
+        if (entity->physicsHandle.baked)
+        {
+            DestroyBodyInternal(*entity);
+        }
+
         entity->shapeData = shapeData;
 
         if (entity->physicsHandle.isValid)
@@ -523,7 +1235,7 @@ namespace SquareCore
     {
         ColliderShapeData data;
         data.shape = ColliderShape::POLYGON;
-        data.polygon.vertices = vertices;
+        data.polygon.vertices = std::make_shared<const std::vector<Vec2>>(vertices);
         SetColliderShape(entityID, data);
     }
 
@@ -544,12 +1256,18 @@ namespace SquareCore
         if (!entity) return;
         
         entity->position = position;
+        entityManagerRef->UpdateSpatialUnsafe(*entity);
+        if (entity->physicsHandle.baked)
+        {
+            DestroyBodyInternal(*entity);
+        }
         if (entity->physicsHandle.isValid && b2Body_IsValid(entity->physicsHandle.bodyId))
         {
             b2Vec2 pos = {ToMeters(position.x), ToMeters(position.y)};
             b2Rot rot = b2Body_GetRotation(entity->physicsHandle.bodyId);
             b2Body_SetTransform(entity->physicsHandle.bodyId, pos, rot);
             b2Body_SetAwake(entity->physicsHandle.bodyId, true);
+            entity->physicsHandle.sleeping = false;
         }
     }
 
@@ -570,12 +1288,18 @@ namespace SquareCore
         if (!entity) return;
 
         entity->rotation = rotation;
+        entityManagerRef->UpdateSpatialUnsafe(*entity);
+        if (entity->physicsHandle.baked)
+        {
+            DestroyBodyInternal(*entity);
+        }
         if (entity->physicsHandle.isValid && b2Body_IsValid(entity->physicsHandle.bodyId))
         {
             b2Vec2 pos = b2Body_GetPosition(entity->physicsHandle.bodyId);
             b2Rot rot = b2MakeRot(ToRadians(rotation));
             b2Body_SetTransform(entity->physicsHandle.bodyId, pos, rot);
             b2Body_SetAwake(entity->physicsHandle.bodyId, true);
+            entity->physicsHandle.sleeping = false;
         }
     }
 
@@ -596,6 +1320,7 @@ namespace SquareCore
         if (!entity) return;
 
         entity->scale = scale;
+        entityManagerRef->UpdateSpatialUnsafe(*entity);
         
         if (entity->physicsHandle.isValid)
         {
@@ -622,6 +1347,7 @@ namespace SquareCore
         
         b2Vec2 f = {ToMeters(force.x), ToMeters(force.y)};
         b2Body_ApplyForceToCenter(entity->physicsHandle.bodyId, f, true);
+        entity->physicsHandle.sleeping = false;
     }
 
     void Physics::ApplyImpulse(uint32_t entityID, const Vec2& impulse)
@@ -642,6 +1368,7 @@ namespace SquareCore
         
         b2Vec2 imp = {ToMeters(impulse.x), ToMeters(impulse.y)};
         b2Body_ApplyLinearImpulseToCenter(entity->physicsHandle.bodyId, imp, true);
+        entity->physicsHandle.sleeping = false;
     }
 
     void Physics::SetVelocity(uint32_t entityID, const Vec2& velocity)
@@ -666,6 +1393,7 @@ namespace SquareCore
             b2Vec2 vel = {ToMeters(velocity.x), ToMeters(velocity.y)};
             b2Body_SetLinearVelocity(entity->physicsHandle.bodyId, vel);
             b2Body_SetAwake(entity->physicsHandle.bodyId, true);
+            entity->physicsHandle.sleeping = false;
         }
     }
 
@@ -687,7 +1415,7 @@ namespace SquareCore
 
         entity->mass = mass;
 
-        if (entity->physicsHandle.isValid && b2Body_IsValid(entity->physicsHandle.bodyId))
+        if (entity->physicsHandle.isValid && !entity->physicsHandle.baked && b2Body_IsValid(entity->physicsHandle.bodyId))
         {
             b2MassData massData;
             massData.mass = mass;
@@ -770,6 +1498,38 @@ namespace SquareCore
         }
     }
 
+    void Physics::SetBullet(uint32_t entityID, bool bullet)
+    {
+        if (!entityManagerRef) return;
+        std::lock_guard<std::mutex> lock(entityManagerRef->GetMutex());
+
+        std::vector<Entity>& entities = entityManagerRef->GetEntitiesUnsafe();
+        Entity* entity = nullptr;
+        for (Entity& e : entities) {
+            if (e.ID == entityID) {
+                entity = &e;
+                break;
+            }
+        }
+
+        if (!entity) return;
+        
+        entity->isBullet = bullet;
+        if (entity->physicsHandle.isValid && !entity->physicsHandle.baked && b2Body_IsValid(entity->physicsHandle.bodyId))
+        {
+            b2Body_SetBullet(entity->physicsHandle.bodyId, bullet);
+        }
+    }
+
+    bool Physics::IsSleeping(uint32_t entityID) const
+    {
+        if (!entityManagerRef) return false;
+        std::lock_guard<std::mutex> lock(entityManagerRef->GetMutex());
+
+        const Entity* entity = entityManagerRef->GetEntityByIDUnsafe(entityID);
+        return entity && entity->physicsHandle.isValid && entity->physicsHandle.sleeping;
+    }
+
     Vec2 Physics::ToMeters(const Vec2& val)
     {
         return Vec2(val.x/100.0f, val.y/100.0f);
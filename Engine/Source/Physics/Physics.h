@@ -8,6 +8,7 @@
 #include <box2d/box2d.h>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 
 namespace SquareCore{
 
@@ -32,6 +33,33 @@ public:
     void CreateBody(uint32_t entityID);
     void DestroyBody(uint32_t entityID);
     void ClearBodies();
+    // Destroys an entity's body, the entity mutex must already be held
+    void DestroyBodyUnsafe(Entity& entity) { DestroyBodyInternal(entity); }
+    // Destroys the bodies of several entities in one pass, the entity mutex must already be held
+    void DestroyBodiesUnsafe(const std::unordered_set<uint32_t>& entityIDs);
+    
+    // Merges adjacent static SOLID box colliders that share tags into shared static bodies on the next step
+    void RequestStaticBake() { staticBakePending = true; }
+    
+    // Captures transforms, velocities, sleep states and entity runtime state into a snapshot
+    void SaveSnapshot(PhysicsSnapshot& snapshot);
+    // Restores a snapshot in place without re-creating bodies, entities missing from the world are skipped
+    bool RestoreSnapshot(const PhysicsSnapshot& snapshot);
+    
+    // Keeps the bounds of every body for the last frameCount recorded frames, 0 disables recording
+    void SetHistoryCapacity(size_t frameCount);
+    // Records current body bounds stamped with the simulation time they belong to (milliseconds)
+    void RecordHistory(uint64_t timestamp);
+    void ClearHistory();
+    // Returns the entities whose recorded bounds overlapped the box at a past time, interpolated between
+    // recorded frames; times outside the recorded window are clamped to its oldest or newest frame
+    std::vector<uint32_t> OverlapBoxAt(uint64_t timestamp, Vec2 center, Vec2 halfExtents, uint32_t ignoreEntityID = 0) const;
+    // Gets an entity's recorded position at a past time, returns false if it wasn't recorded then
+    bool GetPositionAt(uint32_t entityID, uint64_t timestamp, Vec2& position) const;
+    
+    // Enables per-phase timing of Update, read back with GetLastStepProfile
+    void SetProfilingEnabled(bool enabled) { profilingEnabled = enabled; }
+    const PhysicsStepProfile& GetLastStepProfile() const { return lastStepProfile; }
     
     void SetColliderBox(uint32_t entityID, float halfWidth, float halfHeight);
     void SetColliderCircle(uint32_t entityID, float radius, Vec2 center = Vec2::zero());
@@ -50,6 +78,10 @@ public:
     void SetDrag(uint32_t entityID, float drag);
     void SetGravityScale(uint32_t entityID, float gravityScale);
     void SetFixedRotation(uint32_t entityID, bool fixed);
+    // Enables continuous collision for fast movers; trigger and position-driven bullets are swept each step
+    void SetBullet(uint32_t entityID, bool bullet);
+    // Returns true while the entity's body is at rest, resting bodies are not synced back to the entity
+    bool IsSleeping(uint32_t entityID) const;
 
 private:
     b2WorldId worldId;
@@ -60,23 +92,80 @@ private:
     
     std::unordered_map<uint32_t, std::vector<CollisionInfo>> collisionMap;
     std::unordered_map<int64_t, uint32_t> shapeToEntityMap;
+    
+    // Entity covered by a region of a merged static shape (centimeters)
+    struct BakedMember {
+        uint32_t entityID;
+        Vec2 min;
+        Vec2 max;
+    };
+    std::unordered_map<int64_t, std::vector<BakedMember>> bakedShapeMembers;
+    std::unordered_map<int64_t, std::vector<uint32_t>> bakedBodyMembers;
+    bool staticBakePending = false;
+    // Members left behind when one entity leaves a merged body, baked again on the next step
+    std::unordered_set<uint32_t> rebakeMembers;
+    
+    // Start of a bullet's movement this step, swept against the world once the step finishes
+    struct BulletSweep {
+        size_t entityIndex;
+        b2Transform start;
+    };
+    std::vector<BulletSweep> bulletSweeps;
+    
+    bool profilingEnabled = false;
+    PhysicsStepProfile lastStepProfile;
+    
+    // Body bounds at one recorded tick (centimeters), records are sorted by entity ID
+    struct HistoryRecord {
+        uint32_t entityID;
+        Vec2 position;
+        Vec2 min;
+        Vec2 max;
+    };
+    struct HistoryFrame {
+        uint64_t timestamp = 0;
+        std::vector<HistoryRecord> records;
+    };
+    // Ring buffer of recorded frames, slots are reused so recording doesn't allocate once warm
+    std::vector<HistoryFrame> historyFrames;
+    size_t historyHead = 0;
+    size_t historyCount = 0;
 
     void CreateBodyInternal(Entity& entity);
     void DestroyBodyInternal(Entity& entity);
     void SetColliderShape(uint32_t entityID, const ColliderShapeData& shapeData);
     void SyncBodyToEntity(Entity& entity);
-    void SyncEntityToBody(Entity& entity);
+    void SyncEntityToBody(Entity& entity, const b2Transform& transform);
     void UpdateCollisions(std::vector<Entity>& entities);
     
     void ProcessContactEvents(std::vector<Entity>& entities);
     void ProcessSensorEvents();
+    void ProcessBulletSweeps(std::vector<Entity>& entities);
+    bool NeedsBulletSweep(const Entity& entity) const;
+    void RecordContact(uint32_t entityID, uint32_t otherEntityId, b2Vec2 normal, Vec2 point);
+    
+    // Bakes every candidate, or only the candidates in onlyIDs when given
+    void BakeStaticGeometry(std::vector<Entity>& entities, const std::unordered_set<uint32_t>* onlyIDs = nullptr);
+    bool IsStaticBakeCandidate(const Entity& entity) const;
+    // Destroys a merged body, the other members are queued for re-baking when removedEntityID leaves it
+    void UnbakeBody(b2BodyId bodyId, uint32_t removedEntityID = 0);
+    
+    bool FindHistoryFrames(uint64_t timestamp, const HistoryFrame*& older, const HistoryFrame*& newer, float& alpha) const;
+    static const HistoryRecord* FindHistoryRecord(const HistoryFrame& frame, uint32_t entityID);
     
     int ComputeCollisionSide(const b2Vec2& normal) const;
+    // Entity owning an unmerged shape, 0 for merged shapes; use GetEntityFromShapeAt unless the shape is known
+    // to be unmerged
     uint32_t GetEntityFromShape(b2ShapeId shapeId) const;
+    // Entity owning a shape, merged shapes resolve to the member closest to the point
+    uint32_t GetEntityFromShapeAt(b2ShapeId shapeId, b2Vec2 point);
+    static int64_t ShapeKey(b2ShapeId shapeId);
+    static int64_t BodyKey(b2BodyId bodyId);
     
     void RegisterShape(b2ShapeId shapeId, uint32_t entityID);
     void UnregisterShape(b2ShapeId shapeId);
     b2ShapeId CreateShapeForBody(b2BodyId bodyId, const Entity& entity);
+    Vec2 ComputeBoxHalfExtents(const Entity& entity) const;
     
     Vec2 ToMeters(const Vec2& val);
     Vec2 ToCentimeters(const Vec2& val);
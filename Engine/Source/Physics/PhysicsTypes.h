@@ -1,5 +1,7 @@
 #pragma once
 
+#include <cstdint>
+#include <memory>
 #include <vector>
 
 #include "Math/Math.h"
@@ -35,7 +37,8 @@ namespace SquareCore
     
     struct PolygonShapeData
     {
-        std::vector<Vec2> vertices = {};
+        // Shared by copies of the shape (every instance of a prefab), replaced as a whole rather than edited
+        std::shared_ptr<const std::vector<Vec2>> vertices;
     };
     
     struct ColliderShapeData
@@ -54,4 +57,20 @@ namespace SquareCore
         Vec2 normal;
         Vec2 point;
     };
-}
+    
+    // Wall-clock time spent in each phase of the last Physics::Update, in milliseconds
+    struct PhysicsStepProfile
+    {
+        float lifecycleMs = 0.0f;   // Static baking and lazy body creation/destruction
+        float syncMs = 0.0f;        // Entity <-> body transform sync before and after the step
+        float stepMs = 0.0f;        // b2World_Step
+        float collisionMs = 0.0f;   // Contact and sensor event processing
+    };
+    
+    // Compact capture of body and entity runtime state, see Physics::SaveSnapshot
+    struct PhysicsSnapshot
+    {
+        std::vector<uint8_t> buffer;
+        uint32_t entityCount = 0;
+    };
+}
\ No newline at end of file
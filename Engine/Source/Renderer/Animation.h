@@ -0,0 +1,74 @@
+#ifndef ANIMATION_H
+#define ANIMATION_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace SquareCore {
+
+enum class AnimationLoopMode : uint8_t {
+    LOOP,       // Wraps back to the first frame
+    ONCE,       // Stops on the last frame
+    PING_PONG   // Plays forwards then backwards
+};
+
+// A run of frames within one sprite sheet
+struct AnimationClip {
+    std::string name;
+    int startFrame = 0;
+    int frameCount = 1;
+    float fps = 10.0f;
+    AnimationLoopMode loopMode = AnimationLoopMode::LOOP;
+};
+
+// Named clips laid out in one sheet, registered once with EntityManager::RegisterAnimationClips and shared by every
+// entity that uses the sheet
+struct AnimationClipSet {
+    uint32_t ID = 0;
+    std::string name;
+    std::vector<AnimationClip> clips;
+
+    // Index of the named clip, -1 if there isn't one
+    int FindClip(const std::string& clipName) const {
+        for (size_t i = 0; i < clips.size(); ++i)
+        {
+            if (clips[i].name == clipName) return static_cast<int>(i);
+        }
+        return -1;
+    }
+};
+
+enum class AnimationEventType : uint8_t {
+    FINISHED,   // A ONCE clip reached its last frame
+    LOOPED      // A LOOP or PING_PONG clip wrapped around
+};
+
+struct AnimationEvent {
+    uint32_t entityID = 0;
+    AnimationEventType type = AnimationEventType::FINISHED;
+    const AnimationClip* clip = nullptr;   // Null when the whole sheet is playing as one strip
+};
+
+// Per-entity playback state, kept only for animated entities. The current frame and the time into it stay on
+// the Entity so rendering, replication and rewind read them as before
+struct AnimationState {
+    const AnimationClipSet* clipSet = nullptr;
+    const AnimationClip* clip = nullptr;
+    int startFrame = 0;
+    int frameCount = 1;
+    float fps = 0.0f;
+    float frameDuration = 0.0f;        // 1 / fps, 0 when paused
+    AnimationLoopMode loopMode = AnimationLoopMode::LOOP;
+    int phase = 0;                     // Position in a ping-pong cycle, 0 to 2 * (frameCount - 1)
+    bool finished = false;
+
+    void SetRate(float newFps) {
+        fps = newFps > 0.0f ? newFps : 0.0f;
+        frameDuration = fps > 0.0f ? 1.0f / fps : 0.0f;
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,254 @@
+#ifndef COMPONENTS_H
+#define COMPONENTS_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace SquareCore {
+
+// Every component type gets a small ID the first time it is used, no RTTI or registration needed.
+// The ID indexes straight into the registry's pool table. Managers on different threads (listen server and
+// client) can register types at the same time, so the counter is atomic
+inline uint32_t NextComponentTypeID()
+{
+    static std::atomic<uint32_t> next{0};
+    return next.fetch_add(1);
+}
+
+template<typename T>
+uint32_t ComponentTypeID()
+{
+    static const uint32_t id = NextComponentTypeID();
+    return id;
+}
+
+class ComponentPoolBase {
+public:
+    virtual ~ComponentPoolBase() = default;
+
+    virtual void Remove(uint32_t entityID) = 0;
+    virtual void Clear() = 0;
+    // Moves the entity's component, if it has one, into target, which must be a pool of the same type
+    virtual void MoveTo(uint32_t entityID, ComponentPoolBase& target) = 0;
+    virtual std::unique_ptr<ComponentPoolBase> CreateEmpty() const = 0;
+
+    size_t Size() const { return owners.size(); }
+    // Entity owning the component at a dense index
+    uint32_t GetOwner(size_t index) const { return owners[index]; }
+
+protected:
+    std::vector<uint32_t> owners;
+};
+
+// Sparse set of components of one type: the components are packed in a dense array, a sparse array indexed by
+// entity ID points into it. Removal swaps the last component into the hole, so pointers into the pool are only
+// good until the next add or remove of the same type
+template<typename T>
+class ComponentPool final : public ComponentPoolBase {
+public:
+    template<typename... Args>
+    T* Emplace(uint32_t entityID, Args&&... args)
+    {
+        if (entityID >= sparse.size())
+        {
+            sparse.resize(entityID + 1, NONE);
+        }
+
+        uint32_t& slot = sparse[entityID];
+        if (slot != NONE)
+        {
+            dense[slot] = T(std::forward<Args>(args)...);
+            return &dense[slot];
+        }
+
+        slot = static_cast<uint32_t>(dense.size());
+        dense.emplace_back(std::forward<Args>(args)...);
+        owners.push_back(entityID);
+        return &dense.back();
+    }
+
+    T* Get(uint32_t entityID)
+    {
+        if (entityID >= sparse.size() || sparse[entityID] == NONE)
+        {
+            return nullptr;
+        }
+        return &dense[sparse[entityID]];
+    }
+
+    const T* Get(uint32_t entityID) const
+    {
+        return const_cast<ComponentPool*>(this)->Get(entityID);
+    }
+
+    T& At(size_t index) { return dense[index]; }
+
+    void Remove(uint32_t entityID) override
+    {
+        if (entityID >= sparse.size() || sparse[entityID] == NONE)
+        {
+            return;
+        }
+
+        uint32_t index = sparse[entityID];
+        uint32_t last = static_cast<uint32_t>(dense.size() - 1);
+        if (index != last)
+        {
+            dense[index] = std::move(dense[last]);
+            owners[index] = owners[last];
+            sparse[owners[index]] = index;
+        }
+        dense.pop_back();
+        owners.pop_back();
+        sparse[entityID] = NONE;
+    }
+
+    void Clear() override
+    {
+        dense.clear();
+        owners.clear();
+        sparse.clear();
+    }
+
+    void MoveTo(uint32_t entityID, ComponentPoolBase& target) override
+    {
+        if (T* component = Get(entityID))
+        {
+            static_cast<ComponentPool<T>&>(target).Emplace(entityID, std::move(*component));
+            Remove(entityID);
+        }
+    }
+
+    std::unique_ptr<ComponentPoolBase> CreateEmpty() const override
+    {
+        return std::make_unique<ComponentPool<T>>();
+    }
+
+private:
+    static constexpr uint32_t NONE = 0xFFFFFFFFu;
+
+    std::vector<T> dense;
+    std::vector<uint32_t> sparse;
+};
+
+// One pool per component type, created on first use
+class ComponentRegistry {
+public:
+    template<typename T>
+    ComponentPool<T>* GetPool()
+    {
+        uint32_t typeID = ComponentTypeID<T>();
+        if (typeID >= pools.size())
+        {
+            return nullptr;
+        }
+        return static_cast<ComponentPool<T>*>(pools[typeID].get());
+    }
+
+    template<typename T>
+    ComponentPool<T>& AssurePool()
+    {
+        uint32_t typeID = ComponentTypeID<T>();
+        if (typeID >= pools.size())
+        {
+            pools.resize(typeID + 1);
+        }
+        if (!pools[typeID])
+        {
+            pools[typeID] = std::make_unique<ComponentPool<T>>();
+        }
+        return static_cast<ComponentPool<T>&>(*pools[typeID]);
+    }
+
+    void RemoveAll(uint32_t entityID)
+    {
+        for (auto& pool : pools)
+        {
+            if (pool)
+            {
+                pool->Remove(entityID);
+            }
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& pool : pools)
+        {
+            if (pool)
+            {
+                pool->Clear();
+            }
+        }
+    }
+
+    // Moves every component of the entity into the same type's pool in target, creating pools there as needed
+    void MoveEntity(uint32_t entityID, ComponentRegistry& target)
+    {
+        if (target.pools.size() < pools.size())
+        {
+            target.pools.resize(pools.size());
+        }
+        for (size_t typeID = 0; typeID < pools.size(); ++typeID)
+        {
+            if (!pools[typeID])
+            {
+                continue;
+            }
+            if (!target.pools[typeID])
+            {
+                target.pools[typeID] = pools[typeID]->CreateEmpty();
+            }
+            pools[typeID]->MoveTo(entityID, *target.pools[typeID]);
+        }
+    }
+
+    // Calls func(entityID, T&...) for every entity that has all of the given components. Walks the smallest of
+    // the pools backwards, so the callback may remove the current entity or its components
+    template<typename... T, typename Func>
+    void Each(Func&& func)
+    {
+        ComponentPoolBase* candidates[] = { GetPool<T>()... };
+        ComponentPoolBase* smallest = nullptr;
+        for (ComponentPoolBase* pool : candidates)
+        {
+            if (!pool)
+            {
+                return;
+            }
+            if (!smallest || pool->Size() < smallest->Size())
+            {
+                smallest = pool;
+            }
+        }
+
+        for (size_t i = smallest->Size(); i-- > 0;)
+        {
+            if (i >= smallest->Size())
+            {
+                continue;
+            }
+            uint32_t entityID = smallest->GetOwner(i);
+            EachOne<T...>(entityID, func, GetPool<T>()->Get(entityID)...);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<ComponentPoolBase>> pools;
+
+    template<typename... T, typename Func>
+    static void EachOne(uint32_t entityID, Func& func, T*... components)
+    {
+        if ((components && ...))
+        {
+            func(entityID, *components...);
+        }
+    }
+};
+
+}
+
+#endif
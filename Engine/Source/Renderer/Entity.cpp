@@ -1,13 +1,9 @@
 #include "Entity.h"
+#include "Prefab.h"
 #include <algorithm>
 
 namespace SquareCore {
 
-Property::~Property()
-{
-}
-
-
 void Collider::AddCollision(uint32_t entityID, int side) {
     collisions.push_back({entityID, side});
 }
@@ -30,4 +26,20 @@ const std::vector<std::pair<uint32_t, int>>& Collider::GetCollisions() const {
     return collisions;
 }
 
-}
\ No newline at end of file
+bool Entity::HasTag(const std::string& tag) const {
+    if (std::find(tags.begin(), tags.end(), tag) != tags.end()) {
+        return true;
+    }
+    return prefab && std::find(prefab->tags.begin(), prefab->tags.end(), tag) != prefab->tags.end();
+}
+
+std::vector<std::string> Entity::GetAllTags() const {
+    if (!prefab || prefab->tags.empty()) {
+        return tags;
+    }
+    std::vector<std::string> allTags = prefab->tags;
+    allTags.insert(allTags.end(), tags.begin(), tags.end());
+    return allTags;
+}
+
+}
@@ -43,25 +43,26 @@ private:
     std::vector<std::pair<uint32_t, int>> collisions;
 };
 
-struct Property
-{
-    virtual ~Property();
-};
+struct Prefab;
 
 struct PhysicsHandle
 {
     b2BodyId bodyId;
     b2ShapeId shapeId;
     bool isValid = false;
+    bool baked = false;                // Shares a merged static body with other level geometry
+    bool sleeping = false;             // Body is at rest and skipped by transform sync
 };
 
 // Data-only struct that defines variables for entities
 struct Entity {
     uint32_t ID = 0;                   // Internal identifier (default 0 for invalid entity)
     std::string spritePath;            // Path to sprite file (for replication)
-    SDL_Texture* spriteSheet;          // Spritesheet to use for the entity sprite
-    float spriteWidth;                 // Width of sprite frame(s)
-    float spriteHeight;                // Height of sprite frame(s)
+    SDL_Texture* spriteSheet = nullptr; // Spritesheet to use for the entity sprite
+    float spriteWidth = 0.0f;          // Width of sprite frame(s)
+    float spriteHeight = 0.0f;         // Height of sprite frame(s)
+    bool sharedTexture = false;        // Sprite sheet belongs to the EntityManager's texture cache
+    bool texturePending = false;       // Sprite is still loading, not drawn and no body created yet
 
     bool visible = true;
     bool persistent = false;           // If true, this entity will survive scene transitions
@@ -96,14 +97,21 @@ struct Entity {
     float drag = 0.0f;                 // Air resistance/drag coefficient
     float gravityScale = 1.0f;         // Gravity scale multiplier for this entity
     bool fixedRotation = true;
+    bool isBullet = false;             // Continuous collision for fast movers (swept queries for triggers)
 
     // Collision
     Collider collider;                 // The collider for this entity
     PhysicsHandle physicsHandle;
     ColliderShapeData shapeData;
 
-    std::vector<std::string> tags;
-    std::vector<Property*> properties;
+    std::vector<std::string> tags;     // Own tags, on top of the prefab's
+
+    const Prefab* prefab = nullptr;    // Shared template this entity was instantiated from, owned by the EntityManager
+
+    // Checks own and prefab tags
+    bool HasTag(const std::string& tag) const;
+    // Own and prefab tags together
+    std::vector<std::string> GetAllTags() const;
 };
 
 }
@@ -3,6 +3,10 @@
 #include <SDL3_image/SDL_image.h>
 
 #include "algorithm"
+#include <chrono>
+#include <cmath>
+#include <iterator>
+#include <optional>
 
 namespace SquareCore
 {
@@ -12,15 +16,31 @@ namespace SquareCore
 
     EntityManager::~EntityManager()
     {
+        textureLoader.Shutdown();
+        for (auto& [path, surface] : decodedBacklog)
+        {
+            if (surface)
+            {
+                SDL_DestroySurface(surface);
+            }
+        }
+
         std::lock_guard<std::mutex> lock(entityMutex);
         // Clean up any loaded textures
         for (auto& entity : entities)
         {
-            if (entity.spriteSheet != nullptr)
+            if (entity.spriteSheet != nullptr && !entity.sharedTexture)
             {
                 SDL_DestroyTexture(entity.spriteSheet);
             }
         }
+        for (auto& [path, textureInfo] : sharedTextures)
+        {
+            if (textureInfo.texture)
+            {
+                SDL_DestroyTexture(textureInfo.texture);
+            }
+        }
     }
 
     uint32_t EntityManager::AddEntity(const char* spritePath, float Xpos, float Ypos, float rotation,
@@ -59,6 +79,7 @@ namespace SquareCore
         // Add to the entity vector and update the index map
         entities.push_back(newEntity);
         idToIndex[newEntity.ID] = entities.size() - 1;
+        UpdateSpatialUnsafe(newEntity);
 
         return newEntity.ID;
     }
@@ -116,10 +137,251 @@ namespace SquareCore
         // Add to the entity vector and update the index map
         entities.push_back(newEntity);
         idToIndex[newEntity.ID] = entities.size() - 1;
+        TrackAnimationUnsafe(newEntity);
+        UpdateSpatialUnsafe(newEntity);
+
+        return newEntity.ID;
+    }
+
+    uint32_t EntityManager::AddEntityAsync(const char* spritePath, int totalFrames, float fps, float Xpos, float Ypos,
+                                           float rotation, float Xscale, float Yscale, bool physEnabled)
+    {
+        // Headless managers need dimensions right away and never render, so they keep loading synchronously
+        if (headlessMode || !rendererRef)
+        {
+            if (totalFrames > 1)
+            {
+                return AddAnimatedEntity(spritePath, totalFrames, fps, Xpos, Ypos, rotation, Xscale, Yscale, physEnabled);
+            }
+            return AddEntity(spritePath, Xpos, Ypos, rotation, Xscale, Yscale, physEnabled);
+        }
+
+        // Input validation
+        if (!spritePath || spritePath[0] == '\0')
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AddEntityAsync: Invalid sprite path");
+            return 0;
+        }
+        if (totalFrames > 1 && fps <= 0.0f)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AddEntityAsync: Invalid fps value: %f", fps);
+            return 0;
+        }
+
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        if (failedTextures.count(spritePath))
+        {
+            return 0; // Failed to load texture earlier
+        }
+
+        Entity newEntity;
+        newEntity.ID = nextEntityID++;
+        newEntity.spritePath = spritePath; // Store for replication
+        newEntity.position = Vec2(Xpos, Ypos);
+        newEntity.rotation = rotation;
+        newEntity.scale = Vec2(Xscale, Yscale);
+        newEntity.physApplied = physEnabled;
+
+        // Animation properties
+        newEntity.totalFrames = std::max(totalFrames, 1);
+        newEntity.fps = totalFrames > 1 ? fps : 0.0f;
+
+        // Bind straight away if the sprite was loaded before, otherwise wait for the loader
+        auto textureIt = sharedTextures.find(newEntity.spritePath);
+        if (textureIt != sharedTextures.end())
+        {
+            newEntity.spriteSheet = textureIt->second.texture;
+            newEntity.spriteWidth = textureIt->second.width;
+            newEntity.spriteHeight = textureIt->second.height;
+            newEntity.sharedTexture = true;
+        }
+        else
+        {
+            newEntity.spriteSheet = nullptr;
+            newEntity.spriteWidth = 0.0f;
+            newEntity.spriteHeight = 0.0f;
+            newEntity.texturePending = true;
+            pendingTextureEntities[newEntity.spritePath].push_back(newEntity.ID);
+            textureLoader.Request(newEntity.spritePath);
+        }
+
+        // Add to the entity vector and update the index map
+        entities.push_back(newEntity);
+        idToIndex[newEntity.ID] = entities.size() - 1;
+        TrackAnimationUnsafe(newEntity);
+        UpdateSpatialUnsafe(newEntity);
 
         return newEntity.ID;
     }
 
+    void EntityManager::ProcessLoadedTextures(float budgetMs)
+    {
+        std::vector<std::pair<std::string, SDL_Surface*>> decoded = textureLoader.TakeDecoded();
+        decodedBacklog.insert(decodedBacklog.end(), decoded.begin(), decoded.end());
+        if (decodedBacklog.empty() || !rendererRef)
+        {
+            return;
+        }
+
+        // Uploads are spread over frames so a burst of new sprites doesn't spike frame time
+        auto start = std::chrono::steady_clock::now();
+        size_t processed = 0;
+        while (processed < decodedBacklog.size())
+        {
+            if (processed > 0 &&
+                std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count() >= budgetMs)
+            {
+                break;
+            }
+
+            auto& [spritePath, surface] = decodedBacklog[processed++];
+
+            // Upload without holding the entity lock
+            TextureInfo textureInfo = {nullptr, 0.0f, 0.0f};
+            if (surface)
+            {
+                textureInfo.width = static_cast<float>(surface->w);
+                textureInfo.height = static_cast<float>(surface->h);
+                textureInfo.texture = SDL_CreateTextureFromSurface(rendererRef, surface);
+                SDL_DestroySurface(surface);
+                surface = nullptr;
+
+                if (!textureInfo.texture)
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create texture: %s", SDL_GetError());
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(entityMutex);
+
+            if (textureInfo.texture)
+            {
+                sharedTextures[spritePath] = textureInfo;
+            }
+            else
+            {
+                failedTextures.insert(spritePath);
+            }
+
+            // Entities removed while loading are simply no longer in the index
+            auto pendingIt = pendingTextureEntities.find(spritePath);
+            if (pendingIt == pendingTextureEntities.end())
+            {
+                continue;
+            }
+            for (uint32_t entityID : pendingIt->second)
+            {
+                auto it = idToIndex.find(entityID);
+                if (it == idToIndex.end())
+                {
+                    continue;
+                }
+
+                Entity& entity = entities[it->second];
+                entity.texturePending = false;
+                if (textureInfo.texture)
+                {
+                    entity.spriteSheet = textureInfo.texture;
+                    entity.spriteWidth = textureInfo.width;
+                    entity.spriteHeight = textureInfo.height;
+                    entity.sharedTexture = true;
+                    UpdateSpatialUnsafe(entity);
+                }
+                else
+                {
+                    // Keep the entity so IDs stay valid, it just never gets a sprite or body
+                    entity.visible = false;
+                }
+            }
+            pendingTextureEntities.erase(pendingIt);
+        }
+        decodedBacklog.erase(decodedBacklog.begin(), decodedBacklog.begin() + processed);
+    }
+
+    bool EntityManager::HasSharedTexture(const std::string& spritePath) const
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        return sharedTextures.count(spritePath) > 0;
+    }
+
+    void EntityManager::AddSharedTexture(const std::string& spritePath, SDL_Surface* surface)
+    {
+        // Upload without holding the entity lock, headless managers keep the size alone
+        TextureInfo textureInfo = {nullptr, 0.0f, 0.0f};
+        if (surface)
+        {
+            textureInfo.width = static_cast<float>(surface->w);
+            textureInfo.height = static_cast<float>(surface->h);
+            if (!headlessMode && rendererRef)
+            {
+                textureInfo.texture = SDL_CreateTextureFromSurface(rendererRef, surface);
+                if (!textureInfo.texture)
+                {
+                    SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to create texture: %s", SDL_GetError());
+                    textureInfo.width = 0.0f;
+                    textureInfo.height = 0.0f;
+                }
+            }
+            SDL_DestroySurface(surface);
+        }
+
+        std::lock_guard<std::mutex> lock(entityMutex);
+        if (textureInfo.width > 0.0f && textureInfo.height > 0.0f)
+        {
+            auto it = sharedTextures.find(spritePath);
+            if (it != sharedTextures.end())
+            {
+                // Loaded some other way in the meantime, keep the texture entities may already use
+                if (textureInfo.texture)
+                {
+                    SDL_DestroyTexture(textureInfo.texture);
+                }
+                return;
+            }
+            sharedTextures[spritePath] = textureInfo;
+        }
+        else
+        {
+            failedTextures.insert(spritePath);
+        }
+    }
+
+    void EntityManager::ReleaseUnusedSharedTextures(const std::unordered_set<std::string>& keep)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        std::unordered_set<std::string> inUse = keep;
+        for (const Entity& entity : entities)
+        {
+            if (!entity.isSpriteless)
+            {
+                inUse.insert(entity.spritePath);
+            }
+        }
+        // Prefabs hold on to their texture handle for as long as the manager lives
+        for (const auto& prefab : prefabs)
+        {
+            inUse.insert(prefab->base.spritePath);
+        }
+
+        for (auto it = sharedTextures.begin(); it != sharedTextures.end();)
+        {
+            if (inUse.count(it->first) > 0 || pendingTextureEntities.count(it->first) > 0)
+            {
+                ++it;
+                continue;
+            }
+            if (it->second.texture)
+            {
+                SDL_DestroyTexture(it->second.texture);
+            }
+            // Let the loader decode it again the next time something needs it
+            textureLoader.Forget(it->first);
+            it = sharedTextures.erase(it);
+        }
+    }
+
     uint32_t EntityManager::AddSpritelessEntity(float width, float height, RGBA color, float Xpos, float Ypos,
                                                 float rotation, float Xscale, float Yscale, bool physEnabled)
     {
@@ -149,12 +411,311 @@ namespace SquareCore
         // Add to the entity vector and update the index map
         entities.push_back(newEntity);
         idToIndex[newEntity.ID] = entities.size() - 1;
+        UpdateSpatialUnsafe(newEntity);
 
         return newEntity.ID;
     }
 
+    std::vector<uint32_t> EntityManager::CreateBatch(std::span<const Entity> descriptors, bool loadTexturesAsync)
+    {
+        std::vector<uint32_t> ids;
+        ids.reserve(descriptors.size());
+
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        // Grow once instead of reallocating the whole entity vector several times
+        entities.reserve(entities.size() + descriptors.size());
+        idToIndex.reserve(idToIndex.size() + descriptors.size());
+
+        for (const Entity& descriptor : descriptors)
+        {
+            ids.push_back(InsertBatchEntityUnsafe(Entity(descriptor), loadTexturesAsync));
+        }
+
+        return ids;
+    }
+
+    std::vector<uint32_t> EntityManager::CreateBatch(std::vector<Entity>&& descriptors, bool loadTexturesAsync)
+    {
+        std::vector<uint32_t> ids;
+        ids.reserve(descriptors.size());
+
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        entities.reserve(entities.size() + descriptors.size());
+        idToIndex.reserve(idToIndex.size() + descriptors.size());
+
+        for (Entity& descriptor : descriptors)
+        {
+            ids.push_back(InsertBatchEntityUnsafe(std::move(descriptor), loadTexturesAsync));
+        }
+
+        return ids;
+    }
+
+    uint32_t EntityManager::InsertBatchEntityUnsafe(Entity&& entity, bool loadTextureAsync)
+    {
+        entity.spriteSheet = nullptr;
+        entity.sharedTexture = false;
+        entity.texturePending = false;
+        entity.physicsHandle = PhysicsHandle();
+
+        if (entity.totalFrames > 1 && entity.fps <= 0.0f)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "CreateBatch: Invalid fps value: %f", entity.fps);
+            return 0;
+        }
+        entity.totalFrames = std::max(entity.totalFrames, 1);
+
+        if (entity.isSpriteless)
+        {
+            entity.spritePath = "";
+            entity.spriteWidth = entity.spritelessWidth;
+            entity.spriteHeight = entity.spritelessHeight;
+        }
+        else if (loadTextureAsync && !headlessMode && rendererRef)
+        {
+            if (entity.spritePath.empty() || failedTextures.count(entity.spritePath))
+            {
+                return 0;
+            }
+
+            // Bind straight away if the sprite was loaded before, otherwise wait for the loader
+            auto textureIt = sharedTextures.find(entity.spritePath);
+            if (textureIt != sharedTextures.end())
+            {
+                entity.spriteSheet = textureIt->second.texture;
+                entity.spriteWidth = textureIt->second.width;
+                entity.spriteHeight = textureIt->second.height;
+                entity.sharedTexture = true;
+            }
+            else
+            {
+                entity.spriteWidth = 0.0f;
+                entity.spriteHeight = 0.0f;
+                entity.texturePending = true;
+                textureLoader.Request(entity.spritePath);
+            }
+        }
+        else if (!headlessMode || entity.spriteWidth <= 0.0f || entity.spriteHeight <= 0.0f)
+        {
+            TextureInfo textureInfo = GetSharedTextureUnsafe(entity.spritePath);
+            if (!textureInfo.texture && textureInfo.width == 0.0f && textureInfo.height == 0.0f)
+            {
+                return 0;
+            }
+            entity.spriteSheet = textureInfo.texture;
+            entity.spriteWidth = textureInfo.width;
+            entity.spriteHeight = textureInfo.height;
+            entity.sharedTexture = textureInfo.texture != nullptr;
+        }
+
+        if (entity.ID == 0 || entity.ID >= nextEntityID || idToIndex.count(entity.ID) > 0)
+        {
+            entity.ID = nextEntityID++;
+        }
+        if (entity.texturePending)
+        {
+            pendingTextureEntities[entity.spritePath].push_back(entity.ID);
+        }
+
+        uint32_t entityID = entity.ID;
+        idToIndex[entityID] = entities.size();
+        TrackAnimationUnsafe(entity);
+        UpdateSpatialUnsafe(entity);
+        entities.push_back(std::move(entity));
+        return entityID;
+    }
+
+    uint32_t EntityManager::RegisterPrefab(const std::string& name, const Entity& base)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        auto existing = prefabIDs.find(name);
+        if (existing != prefabIDs.end())
+        {
+            return existing->second;
+        }
+
+        auto prefab = std::make_unique<Prefab>();
+        prefab->name = name;
+        prefab->base = base;
+        prefab->tags = std::move(prefab->base.tags);
+        prefab->base.tags.clear();
+        prefab->base.ID = 0;
+        prefab->base.texturePending = false;
+        prefab->base.physicsHandle = PhysicsHandle();
+        prefab->base.totalFrames = std::max(prefab->base.totalFrames, 1);
+
+        // Resolve the sprite once, instances copy the handle
+        if (prefab->base.isSpriteless)
+        {
+            prefab->base.spritePath = "";
+            prefab->base.spriteSheet = nullptr;
+            prefab->base.sharedTexture = false;
+            prefab->base.spriteWidth = prefab->base.spritelessWidth;
+            prefab->base.spriteHeight = prefab->base.spritelessHeight;
+        }
+        else
+        {
+            TextureInfo textureInfo = GetSharedTextureUnsafe(prefab->base.spritePath);
+            if (!textureInfo.texture && textureInfo.width == 0.0f && textureInfo.height == 0.0f)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "RegisterPrefab: Failed to load sprite for %s", name.c_str());
+                return 0;
+            }
+            prefab->base.spriteSheet = textureInfo.texture;
+            prefab->base.spriteWidth = textureInfo.width;
+            prefab->base.spriteHeight = textureInfo.height;
+            prefab->base.sharedTexture = textureInfo.texture != nullptr;
+        }
+
+        prefab->ID = static_cast<uint32_t>(prefabs.size() + 1);
+        prefab->base.prefab = prefab.get();
+        prefabIDs[name] = prefab->ID;
+        prefabs.push_back(std::move(prefab));
+        return prefabs.back()->ID;
+    }
+
+    uint32_t EntityManager::GetPrefabID(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        auto it = prefabIDs.find(name);
+        return it != prefabIDs.end() ? it->second : 0;
+    }
+
+    uint32_t EntityManager::Instantiate(const PrefabInstance& instance)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        return InstantiateUnsafe(instance);
+    }
+
+    std::vector<uint32_t> EntityManager::InstantiateBatch(std::span<const PrefabInstance> instances)
+    {
+        std::vector<uint32_t> ids;
+        ids.reserve(instances.size());
+
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        entities.reserve(entities.size() + instances.size());
+        idToIndex.reserve(idToIndex.size() + instances.size());
+
+        for (const PrefabInstance& instance : instances)
+        {
+            ids.push_back(InstantiateUnsafe(instance));
+        }
+        return ids;
+    }
+
+    uint32_t EntityManager::InstantiateUnsafe(const PrefabInstance& instance)
+    {
+        if (instance.prefabID == 0 || instance.prefabID > prefabs.size())
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Instantiate: Prefab ID %u not found", instance.prefabID);
+            return 0;
+        }
+
+        // The prefab already holds the texture, shape and defaults, only the deltas are applied
+        Entity& entity = entities.emplace_back(prefabs[instance.prefabID - 1]->base);
+        entity.ID = nextEntityID++;
+        entity.position = instance.position;
+        entity.rotation = instance.rotation;
+        if (instance.scale) entity.scale = *instance.scale;
+        if (instance.color) entity.color = *instance.color;
+        if (instance.zIndex) entity.zIndex = *instance.zIndex;
+        if (instance.flipX) entity.flipX = *instance.flipX;
+        if (instance.flipY) entity.flipY = *instance.flipY;
+        if (instance.visible) entity.visible = *instance.visible;
+        if (instance.persistent) entity.persistent = *instance.persistent;
+        entity.tags = instance.extraTags;
+
+        idToIndex[entity.ID] = entities.size() - 1;
+        TrackAnimationUnsafe(entity);
+        UpdateSpatialUnsafe(entity);
+        return entity.ID;
+    }
+
+    uint32_t EntityManager::ReserveEntityIDs(uint32_t count)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        uint32_t first = nextEntityID;
+        nextEntityID += count;
+        return first;
+    }
+
+    std::vector<Entity> EntityManager::TakeEntities(const std::vector<uint32_t>& entityIDs, ComponentRegistry* takenComponents)
+    {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        std::unordered_set<uint32_t> idSet(entityIDs.begin(), entityIDs.end());
+        if (physicsRef)
+        {
+            physicsRef->DestroyBodiesUnsafe(idSet);
+        }
+
+        // Pull the entities out in one pass, the rest keep their order
+        std::vector<Entity> taken;
+        taken.reserve(idSet.size());
+        size_t kept = 0;
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            if (idSet.count(entities[i].ID) > 0)
+            {
+                // Views must not visit entities that left the world
+                if (takenComponents)
+                {
+                    components.MoveEntity(entities[i].ID, *takenComponents);
+                }
+                else
+                {
+                    components.RemoveAll(entities[i].ID);
+                }
+                animations.Remove(entities[i].ID);
+                spatialHash.Remove(entities[i].ID);
+                Entity& entity = taken.emplace_back(std::move(entities[i]));
+                if (entity.spriteSheet && !entity.sharedTexture)
+                {
+                    SDL_DestroyTexture(entity.spriteSheet);
+                }
+                entity.spriteSheet = nullptr;
+                entity.sharedTexture = false;
+            }
+            else
+            {
+                if (kept != i)
+                {
+                    entities[kept] = std::move(entities[i]);
+                }
+                ++kept;
+            }
+        }
+        entities.resize(kept);
+
+        UpdateIndexMap();
+        return taken;
+    }
+
+    void EntityManager::RestoreComponents(const std::vector<uint32_t>& entityIDs, ComponentRegistry& taken)
+    {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        for (uint32_t entityID : entityIDs)
+        {
+            if (idToIndex.count(entityID) > 0)
+            {
+                taken.MoveEntity(entityID, components);
+            }
+        }
+        taken.Clear();
+    }
+
     void EntityManager::RemoveEntity(uint32_t entityID)
     {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        components.RemoveAll(entityID);
+
         std::lock_guard<std::mutex> lock(entityMutex);
 
         auto it = idToIndex.find(entityID);
@@ -163,46 +724,147 @@ namespace SquareCore
             return; // Entity not found
         }
 
-        size_t index = it->second;
-        
-        if (entities[index].physicsHandle.isValid && physicsRef) {
-            uint32_t idToDestroy = entityID;
-            entityMutex.unlock();
-            physicsRef->DestroyBody(idToDestroy);
-            entityMutex.lock();
-            
-            it = idToIndex.find(entityID);
-            if (it == idToIndex.end()) {
-                return;
+        size_t index = it->second;
+        animations.Remove(entityID);
+        spatialHash.Remove(entityID);
+
+        if (physicsRef)
+        {
+            physicsRef->DestroyBodyUnsafe(entities[index]);
+        }
+
+        // Clean up texture if it exists
+        if (entities[index].spriteSheet != nullptr && !entities[index].sharedTexture)
+        {
+            SDL_DestroyTexture(entities[index].spriteSheet);
+        }
+
+        // Remove from entity vector using swap-and-pop for efficiency, only the moved entity changes index
+        idToIndex.erase(it);
+        if (index < entities.size() - 1)
+        {
+            std::swap(entities[index], entities.back());
+            idToIndex[entities[index].ID] = index;
+        }
+        entities.pop_back();
+    }
+
+    void EntityManager::RemoveEntities(std::span<const uint32_t> entityIDs)
+    {
+        if (entityIDs.empty())
+        {
+            return;
+        }
+
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        for (uint32_t entityID : entityIDs)
+        {
+            components.RemoveAll(entityID);
+        }
+
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        std::unordered_set<uint32_t> idSet(entityIDs.begin(), entityIDs.end());
+        size_t kept = 0;
+        for (size_t i = 0; i < entities.size(); ++i)
+        {
+            Entity& entity = entities[i];
+            if (idSet.count(entity.ID) > 0)
+            {
+                animations.Remove(entity.ID);
+                spatialHash.Remove(entity.ID);
+                if (physicsRef)
+                {
+                    physicsRef->DestroyBodyUnsafe(entity);
+                }
+                if (entity.spriteSheet && !entity.sharedTexture)
+                {
+                    SDL_DestroyTexture(entity.spriteSheet);
+                }
+                continue;
+            }
+
+            if (kept != i)
+            {
+                entities[kept] = std::move(entity);
+            }
+            ++kept;
+        }
+        entities.resize(kept);
+
+        UpdateIndexMap();
+    }
+
+    EntityCommandBuffer& EntityManager::GetCommandBuffer()
+    {
+        std::lock_guard<std::mutex> lock(commandBufferMutex);
+        std::unique_ptr<EntityCommandBuffer>& buffer = commandBuffers[std::this_thread::get_id()];
+        if (!buffer)
+        {
+            buffer = std::make_unique<EntityCommandBuffer>(this);
+        }
+        buffer->lastFetched = commandFlushCount;
+        return *buffer;
+    }
+
+    void EntityManager::FlushCommands()
+    {
+        std::vector<Entity> spawns;
+        std::vector<std::unique_ptr<EntityCommandBuffer::ComponentCommand>> componentCommands;
+        std::vector<uint32_t> removals;
+        {
+            std::lock_guard<std::mutex> lock(commandBufferMutex);
+            for (auto it = commandBuffers.begin(); it != commandBuffers.end();)
+            {
+                EntityCommandBuffer& buffer = *it->second;
+                bool idle;
+                {
+                    std::lock_guard<std::mutex> bufferLock(buffer.mutex);
+                    idle = buffer.spawns.empty() && buffer.componentCommands.empty() && buffer.removals.empty();
+                    std::move(buffer.spawns.begin(), buffer.spawns.end(), std::back_inserter(spawns));
+                    std::move(buffer.componentCommands.begin(), buffer.componentCommands.end(), std::back_inserter(componentCommands));
+                    removals.insert(removals.end(), buffer.removals.begin(), buffer.removals.end());
+                    buffer.spawns.clear();
+                    buffer.componentCommands.clear();
+                    buffer.removals.clear();
+                }
+
+                // Buffers of threads that stopped recording would pile up, drop ones not fetched since the last flush.
+                // One fetched since then may still be about to record, so it stays until it goes a frame unused
+                if (idle && buffer.lastFetched < commandFlushCount)
+                {
+                    it = commandBuffers.erase(it);
+                }
+                else
+                {
+                    ++it;
+                }
             }
-            index = it->second;
+            ++commandFlushCount;
         }
 
-        // Clean up texture if it exists
-        if (entities[index].spriteSheet != nullptr)
+        if (!spawns.empty())
         {
-            SDL_DestroyTexture(entities[index].spriteSheet);
+            CreateBatch(std::move(spawns));
         }
-
-        // Remove from entity vector using swap-and-pop for efficiency
-        if (index < entities.size() - 1)
+        for (auto& command : componentCommands)
         {
-            std::swap(entities[index], entities.back());
+            command->Apply(*this);
         }
-        entities.pop_back();
-
-        // Remove from index map and update
-        idToIndex.erase(it);
-        UpdateIndexMap();
+        RemoveEntities(removals);
     }
 
     void EntityManager::ClearEntities()
     {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
         std::lock_guard<std::mutex> lock(entityMutex);
         
         for (int i = static_cast<int>(entities.size()) - 1; i >= 0; --i) {
             if (!entities[i].persistent) {
-                if (entities[i].spriteSheet) {
+                components.RemoveAll(entities[i].ID);
+                animations.Remove(entities[i].ID);
+                spatialHash.Remove(entities[i].ID);
+                if (entities[i].spriteSheet && !entities[i].sharedTexture) {
                     SDL_DestroyTexture(entities[i].spriteSheet);
                 }
                 entities.erase(entities.begin() + i);
@@ -238,13 +900,9 @@ namespace SquareCore
 
         for (Entity& entity : entities)
         {
-            for (const auto& entityTag : entity.tags)
+            if (entity.HasTag(tag))
             {
-                if (entityTag == tag)
-                {
-                    entityIDs.push_back(entity.ID);
-                    break;
-                }
+                entityIDs.push_back(entity.ID);
             }
         }
 
@@ -257,12 +915,9 @@ namespace SquareCore
 
         for (Entity& entity : entities)
         {
-            for (const auto& entityTag : entity.tags)
+            if (entity.HasTag(tag))
             {
-                if (entityTag == tag)
-                {
-                    return entity.ID;
-                }
+                return entity.ID;
             }
         }
 
@@ -295,6 +950,134 @@ namespace SquareCore
         return true;
     }
 
+    std::vector<uint32_t> EntityManager::QueryRect(const Vec2& min, const Vec2& max)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        std::vector<uint32_t> entityIDs;
+        spatialHash.Query(min, max, [&entityIDs](uint32_t entityID, const Vec2&, const Vec2&) {
+            entityIDs.push_back(entityID);
+        });
+        return entityIDs;
+    }
+
+    std::vector<uint32_t> EntityManager::QueryRadius(const Vec2& center, float radius)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        std::vector<uint32_t> entityIDs;
+        if (radius < 0.0f)
+        {
+            return entityIDs;
+        }
+
+        Vec2 extent(radius, radius);
+        spatialHash.Query(center - extent, center + extent,
+            [&](uint32_t entityID, const Vec2& boundsMin, const Vec2& boundsMax) {
+                // Closest point of the bounds to the center
+                float dx = std::clamp(center.x, boundsMin.x, boundsMax.x) - center.x;
+                float dy = std::clamp(center.y, boundsMin.y, boundsMax.y) - center.y;
+                if (dx * dx + dy * dy <= radius * radius)
+                {
+                    entityIDs.push_back(entityID);
+                }
+            });
+        return entityIDs;
+    }
+
+    uint32_t EntityManager::Nearest(const std::string& tag, const Vec2& from, float maxDistance)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        Vec2 extentsMin, extentsMax;
+        if (!spatialHash.GetExtents(extentsMin, extentsMax) || maxDistance < 0.0f)
+        {
+            return 0;
+        }
+
+        // Widen a square around the point until it holds a match closer than its half size. An entity's bounds
+        // contain its position, so nothing outside the square can be closer
+        uint32_t nearestID = 0;
+        float nearestDistSq = maxDistance == FLT_MAX ? FLT_MAX : maxDistance * maxDistance;
+        float radius = std::min(512.0f, maxDistance);
+        while (true)
+        {
+            Vec2 extent(radius, radius);
+            spatialHash.Query(from - extent, from + extent, [&](uint32_t entityID, const Vec2&, const Vec2&) {
+                Entity* entity = GetEntityByIDUnsafe(entityID);
+                if (!entity || !entity->HasTag(tag))
+                {
+                    return;
+                }
+                float dx = entity->position.x - from.x;
+                float dy = entity->position.y - from.y;
+                float distSq = dx * dx + dy * dy;
+                if (distSq <= nearestDistSq)
+                {
+                    nearestDistSq = distSq;
+                    nearestID = entityID;
+                }
+            });
+
+            bool coversWorld = from.x - radius <= extentsMin.x && from.y - radius <= extentsMin.y &&
+                               from.x + radius >= extentsMax.x && from.y + radius >= extentsMax.y;
+            if ((nearestID != 0 && nearestDistSq <= radius * radius) || radius >= maxDistance || coversWorld)
+            {
+                return nearestID;
+            }
+            radius = std::min(radius * 2.0f, maxDistance);
+        }
+    }
+
+    std::vector<Entity> EntityManager::GetEntitiesInRectCopy(const Vec2& min, const Vec2& max)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        // Copied in entity order so draw order among equal z-indices matches GetEntitiesCopy
+        std::vector<size_t> indices;
+        spatialHash.Query(min, max, [this, &indices](uint32_t entityID, const Vec2&, const Vec2&) {
+            auto it = idToIndex.find(entityID);
+            if (it != idToIndex.end())
+            {
+                indices.push_back(it->second);
+            }
+        });
+        std::sort(indices.begin(), indices.end());
+
+        std::vector<Entity> visible;
+        visible.reserve(indices.size());
+        for (size_t index : indices)
+        {
+            visible.push_back(entities[index]);
+        }
+        return visible;
+    }
+
+    void EntityManager::UpdateSpatial(uint32_t entityID)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        if (Entity* entity = GetEntityByIDUnsafe(entityID))
+        {
+            UpdateSpatialUnsafe(*entity);
+        }
+    }
+
+    void EntityManager::UpdateSpatialUnsafe(const Entity& entity)
+    {
+        float width = entity.isSpriteless ? entity.spritelessWidth : entity.spriteWidth / static_cast<float>(std::max(entity.totalFrames, 1));
+        float height = entity.isSpriteless ? entity.spritelessHeight : entity.spriteHeight;
+        float halfWidth = std::abs(width * entity.scale.x) * 0.5f;
+        float halfHeight = std::abs(height * entity.scale.y) * 0.5f;
+
+        // Any rotation fits inside the circle through the corners
+        if (entity.rotation != 0.0f)
+        {
+            halfWidth = halfHeight = std::sqrt(halfWidth * halfWidth + halfHeight * halfHeight);
+        }
+
+        Vec2 extent(halfWidth, halfHeight);
+        spatialHash.Update(entity.ID, entity.position - extent, entity.position + extent);
+    }
+
     void EntityManager::UpdateEntityPosition(uint32_t entityID, float newX, float newY)
     {
         std::lock_guard<std::mutex> lock(entityMutex);
@@ -303,6 +1086,7 @@ namespace SquareCore
         if (it != idToIndex.end())
         {
             entities[it->second].position = Vec2(newX, newY);
+            UpdateSpatialUnsafe(entities[it->second]);
         }
         else
         {
@@ -334,6 +1118,7 @@ namespace SquareCore
         if (it != idToIndex.end())
         {
             entities[it->second].position = position;
+            UpdateSpatialUnsafe(entities[it->second]);
             
             if (physicsRef && entities[it->second].physicsHandle.isValid)
             {
@@ -372,6 +1157,7 @@ namespace SquareCore
         if (it != idToIndex.end())
         {
             entities[it->second].scale = scale;
+            UpdateSpatialUnsafe(entities[it->second]);
             
             if (physicsRef && entities[it->second].physicsHandle.isValid)
             {
@@ -410,6 +1196,7 @@ namespace SquareCore
         if (it != idToIndex.end())
         {
             entities[it->second].rotation = rotation;
+            UpdateSpatialUnsafe(entities[it->second]);
             
             if (physicsRef && entities[it->second].physicsHandle.isValid)
             {
@@ -578,7 +1365,7 @@ namespace SquareCore
         auto it = idToIndex.find(entityID);
         if (it != idToIndex.end())
         {
-            return std::find(entities[it->second].tags.begin(), entities[it->second].tags.end(), tag) != entities[it->second].tags.end();
+            return entities[it->second].HasTag(tag);
         }
         
         SDL_LogError(SDL_LOG_CATEGORY_ERROR, "EntityHasTag: Entity ID %u not found", entityID);
@@ -622,8 +1409,14 @@ namespace SquareCore
         auto it = idToIndex.find(entityID);
         if (it != idToIndex.end())
         {
-            entities[it->second].currentFrame = 0;
+            AnimationState* state = animations.Get(entityID);
+            entities[it->second].currentFrame = state ? state->startFrame : 0;
             entities[it->second].elapsedTime = 0.0f;
+            if (state)
+            {
+                state->phase = 0;
+                state->finished = false;
+            }
         }
     }
 
@@ -635,6 +1428,10 @@ namespace SquareCore
         {
             Entity& entity = entities[it->second];
             entity.fps = fps;
+            if (AnimationState* state = animations.Get(entityID))
+            {
+                state->SetRate(fps);
+            }
         }
     }
 
@@ -648,6 +1445,11 @@ namespace SquareCore
             if (frame >= 0 && frame < entity.totalFrames)
             {
                 entity.currentFrame = frame;
+                AnimationState* state = animations.Get(entityID);
+                if (state && frame >= state->startFrame && frame < state->startFrame + state->frameCount)
+                {
+                    state->phase = frame - state->startFrame;
+                }
             }
         }
     }
@@ -659,11 +1461,151 @@ namespace SquareCore
         if (it != idToIndex.end())
         {
             const Entity& entity = entities[it->second];
+            if (const AnimationState* state = animations.Get(entityID))
+            {
+                return state->finished || entity.currentFrame >= state->startFrame + state->frameCount - 1;
+            }
             return entity.currentFrame >= entity.totalFrames - 1;
         }
         return false;
     }
 
+    uint32_t EntityManager::RegisterAnimationClips(const std::string& name, std::vector<AnimationClip> clips)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        auto existing = animationClipSetIDs.find(name);
+        if (existing != animationClipSetIDs.end())
+        {
+            return existing->second;
+        }
+
+        if (clips.empty())
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "RegisterAnimationClips: No clips given for %s", name.c_str());
+            return 0;
+        }
+        for (const AnimationClip& clip : clips)
+        {
+            if (clip.startFrame < 0 || clip.frameCount < 1 || clip.fps < 0.0f)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "RegisterAnimationClips: Invalid clip %s in %s",
+                             clip.name.c_str(), name.c_str());
+                return 0;
+            }
+        }
+
+        auto clipSet = std::make_unique<AnimationClipSet>();
+        clipSet->ID = static_cast<uint32_t>(animationClipSets.size() + 1);
+        clipSet->name = name;
+        clipSet->clips = std::move(clips);
+
+        uint32_t clipSetID = clipSet->ID;
+        animationClipSets.push_back(std::move(clipSet));
+        animationClipSetIDs[name] = clipSetID;
+        return clipSetID;
+    }
+
+    uint32_t EntityManager::GetAnimationClipSetID(const std::string& name) const
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        auto it = animationClipSetIDs.find(name);
+        return it != animationClipSetIDs.end() ? it->second : 0;
+    }
+
+    bool EntityManager::SetAnimationClips(uint32_t entityID, uint32_t clipSetID)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        auto it = idToIndex.find(entityID);
+        if (it == idToIndex.end())
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SetAnimationClips: Entity ID %u not found", entityID);
+            return false;
+        }
+        if (clipSetID == 0 || clipSetID > animationClipSets.size())
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "SetAnimationClips: Clip set ID %u not found", clipSetID);
+            return false;
+        }
+
+        AnimationState* state = animations.Get(entityID);
+        if (!state)
+        {
+            state = animations.Emplace(entityID);
+        }
+        state->clipSet = animationClipSets[clipSetID - 1].get();
+        return PlayClipUnsafe(entities[it->second], *state, state->clipSet->clips.front());
+    }
+
+    bool EntityManager::PlayAnimation(uint32_t entityID, const std::string& clipName, bool restart)
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+
+        auto it = idToIndex.find(entityID);
+        AnimationState* state = animations.Get(entityID);
+        if (it == idToIndex.end() || !state || !state->clipSet)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "PlayAnimation: Entity ID %u has no animation clips", entityID);
+            return false;
+        }
+
+        int clipIndex = state->clipSet->FindClip(clipName);
+        if (clipIndex < 0)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "PlayAnimation: No clip %s in %s", clipName.c_str(),
+                         state->clipSet->name.c_str());
+            return false;
+        }
+
+        const AnimationClip& clip = state->clipSet->clips[clipIndex];
+        if (state->clip == &clip && !restart)
+        {
+            return true;
+        }
+        return PlayClipUnsafe(entities[it->second], *state, clip);
+    }
+
+    std::vector<AnimationEvent> EntityManager::GetAnimationEvents() const
+    {
+        std::lock_guard<std::mutex> lock(entityMutex);
+        return animationEvents;
+    }
+
+    void EntityManager::TrackAnimationUnsafe(const Entity& entity)
+    {
+        if (entity.totalFrames <= 1)
+        {
+            return;
+        }
+
+        // Without clips the whole sheet loops as one strip
+        AnimationState* state = animations.Emplace(entity.ID);
+        state->frameCount = entity.totalFrames;
+        state->SetRate(entity.fps);
+    }
+
+    bool EntityManager::PlayClipUnsafe(Entity& entity, AnimationState& state, const AnimationClip& clip)
+    {
+        if (clip.startFrame + clip.frameCount > entity.totalFrames)
+        {
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "PlayAnimation: Clip %s runs past the %d frames of entity %u",
+                         clip.name.c_str(), entity.totalFrames, entity.ID);
+            return false;
+        }
+
+        state.clip = &clip;
+        state.startFrame = clip.startFrame;
+        state.frameCount = clip.frameCount;
+        state.loopMode = clip.loopMode;
+        state.SetRate(clip.fps);
+        state.phase = 0;
+        state.finished = false;
+        entity.currentFrame = clip.startFrame;
+        entity.elapsedTime = 0.0f;
+        return true;
+    }
+
     int EntityManager::GetTotalFrames(uint32_t entityID) const
     {
         std::lock_guard<std::mutex> lock(entityMutex);
@@ -726,7 +1668,15 @@ namespace SquareCore
         auto it = idToIndex.find(entityID);
         if (it != idToIndex.end())
         {
-            auto& tagVec = entities[it->second].tags;
+            Entity& entity = entities[it->second];
+            // Tags shared through a prefab can't be removed from it, the entity takes its own copy instead
+            if (entity.prefab && std::find(entity.prefab->tags.begin(), entity.prefab->tags.end(), tag) != entity.prefab->tags.end())
+            {
+                entity.tags = entity.GetAllTags();
+                entity.prefab = nullptr;
+            }
+
+            auto& tagVec = entity.tags;
             auto tagIt = std::find(tagVec.begin(), tagVec.end(), tag);
             if (tagIt != tagVec.end())
             {
@@ -739,37 +1689,64 @@ namespace SquareCore
         }
     }
 
-    std::vector<Property*> EntityManager::GetAllEntityProperties(uint32_t entityID)
+    void EntityManager::UpdateAnimations(float deltaTime)
     {
         std::lock_guard<std::mutex> lock(entityMutex);
+        animationEvents.clear();
 
-        auto it = idToIndex.find(entityID);
-        if (it != idToIndex.end())
+        // Only animated entities are in the pool. Frames to advance come from one multiply instead of a loop
+        for (size_t i = 0; i < animations.Size(); ++i)
         {
-            return entities[it->second].properties;
-        }
-        
-        SDL_LogError(SDL_LOG_CATEGORY_ERROR, "GetAllEntityProperties: Entity ID %u not found", entityID);
-        return {};
-    }
+            AnimationState& state = animations.At(i);
+            if (state.finished || state.frameDuration == 0.0f)
+            {
+                continue;
+            }
 
-    void EntityManager::UpdateAnimations(float deltaTime)
-    {
-        std::lock_guard<std::mutex> lock(entityMutex);
+            auto it = idToIndex.find(animations.GetOwner(i));
+            if (it == idToIndex.end())
+            {
+                continue;
+            }
+            Entity& entity = entities[it->second];
 
-        // Handle animation updates for entities that need it
-        for (auto& entity : entities)
-        {
-            if (entity.totalFrames > 1)
+            entity.elapsedTime += deltaTime;
+            int advance = static_cast<int>(entity.elapsedTime * state.fps);
+            if (advance == 0)
             {
-                entity.elapsedTime += deltaTime;
-                float frameTime = 1.0f / entity.fps;
+                continue;
+            }
+            entity.elapsedTime -= static_cast<float>(advance) * state.frameDuration;
 
-                while (entity.elapsedTime >= frameTime)
-                {
-                    entity.currentFrame = (entity.currentFrame + 1) % entity.totalFrames;
-                    entity.elapsedTime -= frameTime;
-                }
+            int frame = std::clamp(entity.currentFrame - state.startFrame, 0, state.frameCount - 1);
+            bool wrapped = false;
+            switch (state.loopMode)
+            {
+            case AnimationLoopMode::LOOP:
+                frame += advance;
+                wrapped = frame >= state.frameCount;
+                frame %= state.frameCount;
+                break;
+            case AnimationLoopMode::ONCE:
+                frame = std::min(frame + advance, state.frameCount - 1);
+                state.finished = frame == state.frameCount - 1;
+                break;
+            case AnimationLoopMode::PING_PONG:
+            {
+                int period = std::max(2 * (state.frameCount - 1), 1);
+                state.phase += advance;
+                wrapped = state.phase >= period;
+                state.phase %= period;
+                frame = state.phase < state.frameCount ? state.phase : period - state.phase;
+                break;
+            }
+            }
+            entity.currentFrame = state.startFrame + frame;
+
+            if (state.finished || wrapped)
+            {
+                animationEvents.push_back({entity.ID, state.finished ? AnimationEventType::FINISHED : AnimationEventType::LOOPED,
+                                           state.clip});
             }
         }
     }
@@ -783,6 +1760,31 @@ namespace SquareCore
         }
     }
 
+    TextureInfo EntityManager::GetSharedTextureUnsafe(const std::string& spritePath)
+    {
+        auto it = sharedTextures.find(spritePath);
+        if (it != sharedTextures.end())
+        {
+            return it->second;
+        }
+        if (spritePath.empty() || failedTextures.count(spritePath))
+        {
+            return {nullptr, 0.0f, 0.0f};
+        }
+
+        // Headless managers cache the size alone, the texture stays null
+        TextureInfo textureInfo = LoadTexture(spritePath.c_str());
+        if (!textureInfo.texture && textureInfo.width == 0.0f && textureInfo.height == 0.0f)
+        {
+            failedTextures.insert(spritePath);
+        }
+        else
+        {
+            sharedTextures[spritePath] = textureInfo;
+        }
+        return textureInfo;
+    }
+
     TextureInfo EntityManager::LoadTexture(const char* spritePath)
     {
         TextureInfo result = {nullptr, 0.0f, 0.0f};
@@ -847,4 +1849,115 @@ namespace SquareCore
 
         return result;
     }
+
+    uint32_t EntityCommandBuffer::Spawn(Entity entity)
+    {
+        entity.ID = manager->ReserveEntityIDs(1);
+        uint32_t entityID = entity.ID;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        spawns.push_back(std::move(entity));
+        return entityID;
+    }
+
+    void EntityCommandBuffer::Remove(uint32_t entityID)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        removals.push_back(entityID);
+    }
+
+    EntityBatch::EntityBatch(EntityManager* manager)
+        : manager(manager)
+    {
+        if (manager)
+        {
+            componentLock = std::unique_lock<std::recursive_mutex>(manager->componentMutex);
+            entityLock = std::unique_lock<std::mutex>(manager->entityMutex);
+        }
+    }
+
+    EntityBatch::~EntityBatch()
+    {
+        if (!manager)
+        {
+            return;
+        }
+
+        // Collect what changed while the lock is still held, then hand it to physics without it
+        struct TransformWrite {
+            uint32_t entityID;
+            std::optional<Vec2> position;
+            std::optional<float> rotation;
+            std::optional<Vec2> scale;
+            std::optional<Vec2> velocity;
+        };
+        std::vector<TransformWrite> writes;
+        for (uint32_t entityID : touched)
+        {
+            if (Entity* entity = manager->GetEntityByIDUnsafe(entityID))
+            {
+                manager->UpdateSpatialUnsafe(*entity);
+            }
+        }
+        for (const TrackedTransform& before : tracked)
+        {
+            Entity* entity = manager->GetEntityByIDUnsafe(before.entityID);
+            if (!entity)
+            {
+                continue;
+            }
+
+            auto changed = [](const Vec2& a, const Vec2& b) { return a.x != b.x || a.y != b.y; };
+            TransformWrite write;
+            write.entityID = before.entityID;
+            if (changed(entity->position, before.position)) write.position = entity->position;
+            if (entity->rotation != before.rotation) write.rotation = entity->rotation;
+            if (changed(entity->scale, before.scale)) write.scale = entity->scale;
+            if (changed(entity->velocity, before.velocity)) write.velocity = entity->velocity;
+            if (write.position || write.rotation || write.scale || write.velocity)
+            {
+                writes.push_back(write);
+            }
+        }
+
+        entityLock.unlock();
+        componentLock.unlock();
+
+        Physics* physics = manager->physicsRef;
+        if (!physics)
+        {
+            return;
+        }
+        for (const TransformWrite& write : writes)
+        {
+            if (write.position) physics->SetColliderPosition(write.entityID, *write.position);
+            if (write.rotation) physics->SetColliderRotation(write.entityID, *write.rotation);
+            if (write.scale) physics->SetColliderScale(write.entityID, *write.scale);
+            if (write.velocity) physics->SetVelocity(write.entityID, *write.velocity);
+        }
+    }
+
+    Entity* EntityBatch::Get(uint32_t entityID)
+    {
+        if (!manager)
+        {
+            return nullptr;
+        }
+
+        Entity* entity = manager->GetEntityByIDUnsafe(entityID);
+        if (entity)
+        {
+            Track(*entity);
+        }
+        return entity;
+    }
+
+    void EntityBatch::Track(const Entity& entity)
+    {
+        touched.push_back(entity.ID);
+        if (manager->physicsRef && entity.physicsHandle.isValid)
+        {
+            tracked.push_back({entity.ID, entity.position, entity.rotation, entity.scale, entity.velocity});
+        }
+    }
 }
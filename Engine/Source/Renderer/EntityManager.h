@@ -2,18 +2,30 @@
 #define ENTITYMANAGER_H
 
 #include "Entity.h"
+#include "Prefab.h"
+#include "Components.h"
+#include "Animation.h"
+#include "SpatialHash.h"
 #include "Math/Math.h"
 #include "UI/Color.h"
 #include "Physics/Physics.h"
+#include "TextureLoader.h"
+#include <cfloat>
+#include <span>
 #include <vector>
 #include <unordered_map>
+#include <unordered_set>
 #include <mutex>
 #include <functional>
+#include <memory>
+#include <thread>
 #include <SDL3/SDL.h>
 
 namespace SquareCore {
 
 class Physics;
+class EntityBatch;
+class EntityCommandBuffer;
 
 // Struct to hold texture and its dimensions
 struct TextureInfo {
@@ -39,11 +51,54 @@ public:
     // Thread-safe function to add an animated entity
     uint32_t AddAnimatedEntity(const char* spritePath, int totalFrames, float fps, float Xpos = 0.0f, float Ypos = 0.0f,
         float rotation = 0.0f, float Xscale = 1.0f, float Yscale = 1.0f, bool physEnabled = false, std::vector<std::string> tags = {});
+    // Thread-safe function to add an entity whose sprite is decoded on a background thread, the entity exists
+    // immediately and is bound to its texture by ProcessLoadedTextures (totalFrames > 1 makes it animated)
+    uint32_t AddEntityAsync(const char* spritePath, int totalFrames = 1, float fps = 0.0f, float Xpos = 0.0f, float Ypos = 0.0f,
+        float rotation = 0.0f, float Xscale = 1.0f, float Yscale = 1.0f, bool physEnabled = false);
+    // Uploads finished sprite decodes and binds them to waiting entities, call on the render thread once per frame
+    void ProcessLoadedTextures(float budgetMs = 2.0f);
+    // Thread-safe function to check whether a sprite is already in the shared texture cache
+    bool HasSharedTexture(const std::string& spritePath) const;
+    // Turns a surface decoded elsewhere into the shared texture for its path and frees the surface, call on the
+    // render thread. A null surface marks the path as failed so it isn't loaded again
+    void AddSharedTexture(const std::string& spritePath, SDL_Surface* surface);
+    // Frees shared textures no entity uses anymore apart from the ones in keep, call on the render thread
+    void ReleaseUnusedSharedTextures(const std::unordered_set<std::string>& keep = {});
     // Thread-safe function to add a spriteless entity
     uint32_t AddSpritelessEntity(float width, float height, RGBA color, float Xpos = 0.0f, float Ypos = 0.0f,
         float rotation = 0.0f, float Xscale = 1.0f, float Yscale = 1.0f, bool physEnabled = false);
+    // Thread-safe function to create many entities under one lock from fully specified descriptors (sprite path or
+    // spriteless size, animation, transform, collider, tags...), storage is reserved once for the whole batch.
+    // Returns the new IDs in order, 0 where an entity couldn't be created. Sprites come from the shared texture
+    // cache so each sheet is decoded once; with loadTexturesAsync, sheets not cached yet are decoded in the
+    // background and bound by ProcessLoadedTextures. Headless managers skip decoding for descriptors that already
+    // carry their sprite size, and descriptors carrying an ID from ReserveEntityIDs keep it
+    std::vector<uint32_t> CreateBatch(std::span<const Entity> descriptors, bool loadTexturesAsync = false);
+    // Same as above, moving the descriptors in instead of copying them
+    std::vector<uint32_t> CreateBatch(std::vector<Entity>&& descriptors, bool loadTexturesAsync = false);
+    // Thread-safe function to reserve a block of IDs for entities inserted later, returns the first one
+    uint32_t ReserveEntityIDs(uint32_t count);
+    // Thread-safe function to remove entities and hand back their current state so they can be added again later,
+    // IDs that no longer exist are skipped. Their components leave the pools too, moved into takenComponents if
+    // given and dropped otherwise
+    std::vector<Entity> TakeEntities(const std::vector<uint32_t>& entityIDs, ComponentRegistry* takenComponents = nullptr);
+    // Thread-safe function to hand components saved by TakeEntities back to those of the entities that exist again,
+    // the rest are dropped and taken is left empty
+    void RestoreComponents(const std::vector<uint32_t>& entityIDs, ComponentRegistry& taken);
+    // Thread-safe function to register a shared entity template, its sprite is loaded once here. The tags of base
+    // become the prefab's shared tags. Returns the prefab ID, 0 if the sprite failed to load; registering a name
+    // again returns the existing prefab unchanged
+    uint32_t RegisterPrefab(const std::string& name, const Entity& base);
+    // Thread-safe function to look up a prefab ID by name, 0 if there is none
+    uint32_t GetPrefabID(const std::string& name) const;
+    // Thread-safe function to create an entity from a prefab with the instance's overrides applied
+    uint32_t Instantiate(const PrefabInstance& instance);
+    // Thread-safe function to create many prefab instances under one lock, returns their IDs in order
+    std::vector<uint32_t> InstantiateBatch(std::span<const PrefabInstance> instances);
     // Thread-safe function to remove an entity
     void RemoveEntity(uint32_t entityID);
+    // Thread-safe function to remove several entities with one lock and one index rebuild
+    void RemoveEntities(std::span<const uint32_t> entityIDs);
     // Thread-safe function to clear all entities
     void ClearEntities();
 
@@ -62,6 +117,22 @@ public:
     // Thread-safe function to get a property of an entity
     bool GetEntityProperty(uint32_t ID, std::function<void(const Entity&)> accessor) const;
 
+    // Spatial queries, answered from a grid of entity bounds kept up to date as entities move, so they cost what
+    // is nearby rather than the size of the world. Bounds are the sprite (or spriteless) rectangle after scale,
+    // widened to cover any rotation
+    // Thread-safe function to get the IDs of entities whose bounds overlap a rectangle
+    std::vector<uint32_t> QueryRect(const Vec2& min, const Vec2& max);
+    // Thread-safe function to get the IDs of entities whose bounds overlap a circle
+    std::vector<uint32_t> QueryRadius(const Vec2& center, float radius);
+    // Thread-safe function to find the entity with the tag closest to a point, 0 if none is within maxDistance
+    uint32_t Nearest(const std::string& tag, const Vec2& from, float maxDistance = FLT_MAX);
+    // Thread-safe function to get a copy of the entities whose bounds overlap a rectangle, used to cull rendering
+    std::vector<Entity> GetEntitiesInRectCopy(const Vec2& min, const Vec2& max);
+    // Thread-safe function to refresh an entity's bounds after its transform was written directly
+    void UpdateSpatial(uint32_t entityID);
+    // Function to refresh an entity's bounds while the mutex is already held
+    void UpdateSpatialUnsafe(const Entity& entity);
+
     // Thread-safe function to update an entity's position
     void UpdateEntityPosition(uint32_t entityID, float newX, float newY);
     // Thread-safe function to flip an entity's sprite
@@ -103,35 +174,85 @@ public:
     bool IsAnimationComplete(uint32_t entityID) const;
     int GetTotalFrames(uint32_t entityID) const;
 
+    // Registers named clips within one sprite sheet, shared by every entity given the set. Returns its ID, or the
+    // existing one if the name is taken (0 on failure)
+    uint32_t RegisterAnimationClips(const std::string& name, std::vector<AnimationClip> clips);
+    uint32_t GetAnimationClipSetID(const std::string& name) const;
+    // Gives an entity a clip set and starts its first clip
+    bool SetAnimationClips(uint32_t entityID, uint32_t clipSetID);
+    // Switches to a clip of the entity's set, a clip that is already playing carries on unless restart is set
+    bool PlayAnimation(uint32_t entityID, const std::string& clipName, bool restart = false);
+    // Clips that finished or looped during the last UpdateAnimations
+    std::vector<AnimationEvent> GetAnimationEvents() const;
+
     void SetZIndex(uint32_t entityID, int zIndex);
     int GetZIndex(uint32_t entityID);
     
     void AddTagToEntity(uint32_t entityID, std::string tag);
     void RemoveTagFromEntity(uint32_t entityID, std::string tag);
 
-    void AddPropertyToEntity(uint32_t entityID, Property* property) {
-        std::lock_guard<std::mutex> lock(entityMutex);
-
-        auto it = idToIndex.find(entityID);
-        if (it != idToIndex.end())
+    // Typed components, stored per type in dense pools keyed by entity ID. Adding a component the entity already
+    // has replaces it. Returned pointers stay valid until a component of the same type is added or removed,
+    // so look them up again each frame instead of keeping them
+    template<typename T, typename... Args>
+    T* AddComponent(uint32_t entityID, Args&&... args) {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        if (!EntityExists(entityID))
         {
-            entities[it->second].properties.push_back(property);
+            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AddComponent: Entity ID %u not found", entityID);
+            return nullptr;
         }
-        else
+        return components.AssurePool<T>().Emplace(entityID, std::forward<Args>(args)...);
+    }
+
+    template<typename T>
+    T* GetComponent(uint32_t entityID) {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        ComponentPool<T>* pool = components.GetPool<T>();
+        return pool ? pool->Get(entityID) : nullptr;
+    }
+
+    template<typename T>
+    bool HasComponent(uint32_t entityID) { return GetComponent<T>(entityID) != nullptr; }
+
+    template<typename T>
+    void RemoveComponent(uint32_t entityID) {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        if (ComponentPool<T>* pool = components.GetPool<T>())
         {
-            SDL_LogError(SDL_LOG_CATEGORY_ERROR, "AddPropertyToEntity: Entity ID %u not found", entityID);
+            pool->Remove(entityID);
         }
     }
 
-    std::vector<Property*> GetAllEntityProperties(uint32_t entityID);
+    // Command buffer of the calling thread. Spawns, removals and component changes recorded into it are applied
+    // by FlushCommands, so they're safe to record while iterating. Fetch it again each frame rather than keeping
+    // the reference, buffers left idle for a whole frame are freed by FlushCommands
+    EntityCommandBuffer& GetCommandBuffer();
+    // Applies every thread's recorded commands: spawns first, then component changes in the order they were
+    // recorded, then all removals in one batch. Called once per frame after the scripts have updated
+    void FlushCommands();
+
+    // Calls func(entityID, T&...) for every entity with all of the given components. The callback may remove the
+    // entity it was handed but nothing else, the pools swap-and-pop so other changes can move unvisited entities
+    // into slots already passed. Record anything else into GetCommandBuffer() and let FlushCommands apply it
+    template<typename... T, typename Func>
+    void View(Func&& func) {
+        std::lock_guard<std::recursive_mutex> componentLock(componentMutex);
+        components.Each<T...>(std::forward<Func>(func));
+    }
 
-    // Thread-safe function to update the animations of all entities
+    // Thread-safe function to advance the animated entities
     void UpdateAnimations(float deltaTime);
 
     // Function to get the mutex for thread-safe operations
     std::mutex& GetMutex() { return entityMutex; }
     // Function to get the entity vector for thread-safe operations
     std::vector<Entity>& GetEntitiesUnsafe() { return entities; }
+    // Function to look up an entity by ID while the mutex is already held
+    Entity* GetEntityByIDUnsafe(uint32_t ID) {
+        auto it = idToIndex.find(ID);
+        return it != idToIndex.end() ? &entities[it->second] : nullptr;
+    }
 
 private:
     // Mutex for thread-safe operations
@@ -150,10 +271,177 @@ private:
     // Headless mode flag (no texture loading for server)
     bool headlessMode = false;
 
+    // Asynchronous sprite loading, textures created from it are shared per path and owned here
+    TextureLoader textureLoader;
+    std::unordered_map<std::string, TextureInfo> sharedTextures;
+    std::unordered_set<std::string> failedTextures;
+    std::unordered_map<std::string, std::vector<uint32_t>> pendingTextureEntities;
+    std::vector<std::pair<std::string, SDL_Surface*>> decodedBacklog;  // Render thread only
+
+    // Component pools. The component mutex is always taken before the entity mutex, never while holding it
+    ComponentRegistry components;
+    std::recursive_mutex componentMutex;
+
+    // Playback state of animated entities only, guarded by the entity mutex
+    ComponentPool<AnimationState> animations;
+    std::vector<AnimationEvent> animationEvents;
+    // Registered clip sets, never removed so playback state can point at them (ID is index + 1)
+    std::vector<std::unique_ptr<AnimationClipSet>> animationClipSets;
+    std::unordered_map<std::string, uint32_t> animationClipSetIDs;
+
+    // Entity bounds for spatial queries, guarded by the entity mutex
+    SpatialHash spatialHash;
+
+    // Deferred structural changes, one buffer per recording thread
+    std::unordered_map<std::thread::id, std::unique_ptr<EntityCommandBuffer>> commandBuffers;
+    std::mutex commandBufferMutex;
+    uint64_t commandFlushCount = 0;
+
+    // Registered prefabs, never removed so instances can point at them (ID is index + 1)
+    std::vector<std::unique_ptr<Prefab>> prefabs;
+    std::unordered_map<std::string, uint32_t> prefabIDs;
+
     // Function to load a texture from a file path
     TextureInfo LoadTexture(const char* spritePath);
+    // Function to load a texture into the shared cache once per path, the mutex must be held
+    TextureInfo GetSharedTextureUnsafe(const std::string& spritePath);
+    // Function to insert one batch entity, the mutex must be held
+    uint32_t InsertBatchEntityUnsafe(Entity&& entity, bool loadTextureAsync);
+    // Function to insert one prefab instance, the mutex must be held
+    uint32_t InstantiateUnsafe(const PrefabInstance& instance);
+    // Function to start tracking an animated entity, the mutex must be held
+    void TrackAnimationUnsafe(const Entity& entity);
+    // Function to switch an entity to a clip, the mutex must be held
+    bool PlayClipUnsafe(Entity& entity, AnimationState& state, const AnimationClip& clip);
     // Function to update the index map for entity IDs
     void UpdateIndexMap();
+
+    friend class EntityBatch;
+};
+
+// Scoped bulk access to entities under one acquisition of the entity mutex, for scripts that touch many entities
+// per frame. Fields are read and written directly; position, rotation, scale and velocity changes on entities with
+// physics bodies are pushed to physics when the batch ends. No other EntityManager function may be called while a
+// batch is open on the same thread
+class EntityBatch {
+public:
+    explicit EntityBatch(EntityManager* manager);
+    ~EntityBatch();
+
+    EntityBatch(const EntityBatch&) = delete;
+    EntityBatch& operator=(const EntityBatch&) = delete;
+
+    // Returns nullptr if the entity doesn't exist
+    Entity* Get(uint32_t entityID);
+
+    // Calls func(Entity&) for every entity with the tag
+    template<typename Func>
+    void ForEachWithTag(const std::string& tag, Func&& func) {
+        if (!manager) return;
+        for (Entity& entity : manager->entities)
+        {
+            if (entity.HasTag(tag))
+            {
+                Track(entity);
+                func(entity);
+            }
+        }
+    }
+
+    // Calls func(Entity&, T&...) for every entity with all of the given components
+    template<typename... T, typename Func>
+    void ForEachWith(Func&& func) {
+        if (!manager) return;
+        manager->components.Each<T...>([this, &func](uint32_t entityID, T&... components) {
+            if (Entity* entity = Get(entityID))
+            {
+                func(*entity, components...);
+            }
+        });
+    }
+
+private:
+    struct TrackedTransform {
+        uint32_t entityID;
+        Vec2 position;
+        float rotation;
+        Vec2 scale;
+        Vec2 velocity;
+    };
+
+    EntityManager* manager;
+    std::unique_lock<std::recursive_mutex> componentLock;
+    std::unique_lock<std::mutex> entityLock;
+    // Starting transforms of entities with physics bodies, compared when the batch ends
+    std::vector<TrackedTransform> tracked;
+    // Entities handed out, their bounds are refreshed when the batch ends
+    std::vector<uint32_t> touched;
+
+    void Track(const Entity& entity);
+};
+
+// Structural changes recorded by one thread, applied later by EntityManager::FlushCommands
+class EntityCommandBuffer {
+public:
+    explicit EntityCommandBuffer(EntityManager* manager) : manager(manager) {}
+
+    // Queues an entity to be created from a descriptor as in CreateBatch. Its ID is reserved right away so later
+    // commands and scripts can refer to it, although it doesn't exist until the flush
+    uint32_t Spawn(Entity entity);
+    void Remove(uint32_t entityID);
+
+    // The component is built now and moved in at the flush, so move-only components work
+    template<typename T, typename... Args>
+    void AddComponent(uint32_t entityID, Args&&... args) {
+        auto command = std::make_unique<AddComponentCommand<T>>(entityID, std::forward<Args>(args)...);
+        std::lock_guard<std::mutex> lock(mutex);
+        componentCommands.push_back(std::move(command));
+    }
+
+    template<typename T>
+    void RemoveComponent(uint32_t entityID) {
+        auto command = std::make_unique<RemoveComponentCommand<T>>(entityID);
+        std::lock_guard<std::mutex> lock(mutex);
+        componentCommands.push_back(std::move(command));
+    }
+
+private:
+    // Recorded component change, type-erased so the buffer can hold any component type
+    struct ComponentCommand {
+        virtual ~ComponentCommand() = default;
+        virtual void Apply(EntityManager& target) = 0;
+    };
+
+    template<typename T>
+    struct AddComponentCommand : ComponentCommand {
+        uint32_t entityID;
+        T component;
+
+        template<typename... Args>
+        explicit AddComponentCommand(uint32_t entityID, Args&&... args)
+            : entityID(entityID), component(std::forward<Args>(args)...) {}
+
+        void Apply(EntityManager& target) override { target.AddComponent<T>(entityID, std::move(component)); }
+    };
+
+    template<typename T>
+    struct RemoveComponentCommand : ComponentCommand {
+        uint32_t entityID;
+
+        explicit RemoveComponentCommand(uint32_t entityID) : entityID(entityID) {}
+
+        void Apply(EntityManager& target) override { target.RemoveComponent<T>(entityID); }
+    };
+
+    EntityManager* manager;
+    std::mutex mutex;
+    std::vector<Entity> spawns;
+    std::vector<std::unique_ptr<ComponentCommand>> componentCommands;
+    std::vector<uint32_t> removals;
+    // Flush count when the owning thread last fetched this buffer, guarded by the manager's commandBufferMutex
+    uint64_t lastFetched = 0;
+
+    friend class EntityManager;
 };
 
 }
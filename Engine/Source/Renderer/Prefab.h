@@ -0,0 +1,39 @@
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include "Entity.h"
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace SquareCore {
+
+// Shared template for entities that are spawned many times. Registered once with EntityManager::RegisterPrefab
+// and never changed afterwards: its sprite is resolved at registration, its collider polygon is shared with every
+// instance and its tags are looked up through the instance instead of being copied into it
+struct Prefab {
+    uint32_t ID = 0;
+    std::string name;
+    Entity base;                       // Defaults for instances, without tags
+    std::vector<std::string> tags;
+};
+
+// The small per-instance record a prefab is instantiated from, only the fields that differ from the prefab are set
+struct PrefabInstance {
+    uint32_t prefabID = 0;
+    Vec2 position = Vec2::zero();
+    float rotation = 0.0f;
+
+    std::optional<Vec2> scale;
+    std::optional<RGBA> color;
+    std::optional<int> zIndex;
+    std::optional<bool> flipX;
+    std::optional<bool> flipY;
+    std::optional<bool> visible;
+    std::optional<bool> persistent;
+    std::vector<std::string> extraTags;  // Added on top of the prefab's tags
+};
+
+}
+
+#endif
@@ -66,8 +66,13 @@ namespace SquareCore
         float globalScaleX, globalScaleY;
         CalculateScalingFactors(globalScaleX, globalScaleY);
 
-        // Get entities copy for rendering (thread-safe)
-        std::vector<Entity> entities = entityManager.GetEntitiesCopy();
+        // Only copy out entities inside the camera's view (thread-safe), the margin keeps debug colliders larger
+        // than their sprite from popping at the edges
+        float zoom = camera.GetZoom();
+        Vec2 viewExtent((static_cast<float>(windowWidth) / 2.0f) / (zoom * globalScaleX) + viewCullMargin,
+                        (static_cast<float>(windowHeight) / 2.0f) / (zoom * globalScaleY) + viewCullMargin);
+        Vec2 cameraPos = camera.GetPosition();
+        std::vector<Entity> entities = entityManager.GetEntitiesInRectCopy(cameraPos - viewExtent, cameraPos + viewExtent);
         std::sort(entities.begin(), entities.end(), [](const Entity& a, const Entity& b) { return a.zIndex < b.zIndex; });
 
         // Render all entities
@@ -449,8 +454,11 @@ namespace SquareCore
             break;
 
         case ColliderShape::POLYGON:
-            DrawDebugPolygon(screenCenter, entity.shapeData.polygon.vertices,
-                             screenRotation, effectiveScaleX, effectiveScaleY, color);
+            if (entity.shapeData.polygon.vertices)
+            {
+                DrawDebugPolygon(screenCenter, *entity.shapeData.polygon.vertices,
+                                 screenRotation, effectiveScaleX, effectiveScaleY, color);
+            }
             break;
 
         case ColliderShape::BOX:
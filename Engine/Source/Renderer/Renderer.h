@@ -69,6 +69,8 @@ private:
     ScalingMode scalingMode = ScalingMode::Proportional;
     static constexpr float baseWindowWidth = 1920.0f;
     static constexpr float baseWindowHeight = 1080.0f;
+    // World-space slack around the view when culling entities
+    static constexpr float viewCullMargin = 256.0f;
     // Function to calculate scaling factors for scaling modes
     void CalculateScalingFactors(float& scaleX, float& scaleY) const;
 
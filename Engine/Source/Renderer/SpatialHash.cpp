@@ -0,0 +1,157 @@
+#include "SpatialHash.h"
+#include <algorithm>
+#include <cmath>
+
+namespace SquareCore {
+
+void SpatialHash::Update(uint32_t entityID, const Vec2& min, const Vec2& max)
+{
+    CellRange range = GetCellRange(min, max);
+    bool isOversized = CellCount(range) > MAX_CELLS_PER_ENTITY;
+
+    Entry* entry = entries.Get(entityID);
+    if (entry && entry->range == range && entry->oversized == isOversized)
+    {
+        // Still in the same cells, only the bounds moved
+        entry->min = min;
+        entry->max = max;
+    }
+    else
+    {
+        if (entry)
+        {
+            Unlink(entityID, *entry);
+        }
+
+        Entry updated;
+        updated.min = min;
+        updated.max = max;
+        updated.range = range;
+        updated.oversized = isOversized;
+        updated.stamp = entry ? entry->stamp : 0;
+        Link(entityID, updated);
+        entries.Emplace(entityID, updated);
+    }
+
+    if (!hasExtents)
+    {
+        extentsMin = min;
+        extentsMax = max;
+        hasExtents = true;
+    }
+    else
+    {
+        extentsMin.x = std::min(extentsMin.x, min.x);
+        extentsMin.y = std::min(extentsMin.y, min.y);
+        extentsMax.x = std::max(extentsMax.x, max.x);
+        extentsMax.y = std::max(extentsMax.y, max.y);
+    }
+}
+
+void SpatialHash::Remove(uint32_t entityID)
+{
+    Entry* entry = entries.Get(entityID);
+    if (!entry)
+    {
+        return;
+    }
+
+    Unlink(entityID, *entry);
+    entries.Remove(entityID);
+}
+
+void SpatialHash::Clear()
+{
+    cells.clear();
+    entries.Clear();
+    oversized.clear();
+    hasExtents = false;
+    extentsMin = Vec2::zero();
+    extentsMax = Vec2::zero();
+}
+
+bool SpatialHash::GetExtents(Vec2& min, Vec2& max) const
+{
+    min = extentsMin;
+    max = extentsMax;
+    return hasExtents;
+}
+
+SpatialHash::CellRange SpatialHash::GetCellRange(const Vec2& min, const Vec2& max) const
+{
+    // Clamped so huge or non-finite bounds can't overflow the cell coordinates
+    constexpr float LIMIT = 1.0e6f;
+    auto cell = [this](float value) {
+        float scaled = std::floor(value / cellSize);
+        if (!(scaled > -LIMIT)) return static_cast<int>(-LIMIT);
+        if (!(scaled < LIMIT)) return static_cast<int>(LIMIT);
+        return static_cast<int>(scaled);
+    };
+
+    CellRange range;
+    range.minX = cell(min.x);
+    range.minY = cell(min.y);
+    range.maxX = cell(max.x);
+    range.maxY = cell(max.y);
+    return range;
+}
+
+size_t SpatialHash::CellCount(const CellRange& range)
+{
+    if (range.maxX < range.minX || range.maxY < range.minY)
+    {
+        return 0;
+    }
+    return static_cast<size_t>(range.maxX - range.minX + 1) * static_cast<size_t>(range.maxY - range.minY + 1);
+}
+
+void SpatialHash::Link(uint32_t entityID, const Entry& entry)
+{
+    if (entry.oversized)
+    {
+        oversized.push_back(entityID);
+        return;
+    }
+
+    for (int y = entry.range.minY; y <= entry.range.maxY; ++y)
+    {
+        for (int x = entry.range.minX; x <= entry.range.maxX; ++x)
+        {
+            cells[CellKey(x, y)].push_back(entityID);
+        }
+    }
+}
+
+void SpatialHash::Unlink(uint32_t entityID, const Entry& entry)
+{
+    auto erase = [entityID](std::vector<uint32_t>& list) {
+        auto it = std::find(list.begin(), list.end(), entityID);
+        if (it != list.end())
+        {
+            *it = list.back();
+            list.pop_back();
+        }
+    };
+
+    if (entry.oversized)
+    {
+        erase(oversized);
+        return;
+    }
+
+    for (int y = entry.range.minY; y <= entry.range.maxY; ++y)
+    {
+        for (int x = entry.range.minX; x <= entry.range.maxX; ++x)
+        {
+            auto it = cells.find(CellKey(x, y));
+            if (it == cells.end()) continue;
+            erase(it->second);
+            if (it->second.empty())
+            {
+                cells.erase(it);
+            }
+        }
+    }
+}
+
+}
@@ -0,0 +1,114 @@
+#ifndef SPATIALHASH_H
+#define SPATIALHASH_H
+
+#include "Components.h"
+#include "Math/Math.h"
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace SquareCore {
+
+// Uniform grid over entity bounds for neighbourhood queries. Each entity is listed in every cell its bounds touch,
+// so a query only looks at the cells it covers and costs what is nearby rather than what is in the world.
+// Not thread-safe, the EntityManager guards it with the entity mutex
+class SpatialHash {
+public:
+    explicit SpatialHash(float cellSize = 512.0f) : cellSize(cellSize) {}
+
+    // Inserts an entity or moves it to new bounds, cheap when it stays within the same cells
+    void Update(uint32_t entityID, const Vec2& min, const Vec2& max);
+    void Remove(uint32_t entityID);
+    void Clear();
+
+    // Calls visit(entityID, boundsMin, boundsMax) once for every entity whose bounds overlap the rectangle
+    template<typename Visit>
+    void Query(const Vec2& min, const Vec2& max, Visit&& visit)
+    {
+        ++queryStamp;
+        auto test = [&](uint32_t entityID) {
+            Entry* entry = entries.Get(entityID);
+            if (!entry || entry->stamp == queryStamp) return;
+            entry->stamp = queryStamp;
+            if (entry->max.x >= min.x && entry->min.x <= max.x && entry->max.y >= min.y && entry->min.y <= max.y)
+            {
+                visit(entityID, entry->min, entry->max);
+            }
+        };
+
+        for (uint32_t entityID : oversized)
+        {
+            test(entityID);
+        }
+
+        CellRange range = GetCellRange(min, max);
+        if (CellCount(range) > cells.size())
+        {
+            // Covers more cells than are occupied, walk the occupied ones instead
+            for (auto& [key, cell] : cells)
+            {
+                int x = static_cast<int32_t>(key >> 32);
+                int y = static_cast<int32_t>(key & 0xFFFFFFFFu);
+                if (x < range.minX || x > range.maxX || y < range.minY || y > range.maxY) continue;
+                for (uint32_t entityID : cell) test(entityID);
+            }
+            return;
+        }
+        for (int y = range.minY; y <= range.maxY; ++y)
+        {
+            for (int x = range.minX; x <= range.maxX; ++x)
+            {
+                auto it = cells.find(CellKey(x, y));
+                if (it == cells.end()) continue;
+                for (uint32_t entityID : it->second) test(entityID);
+            }
+        }
+    }
+
+    // Bounds of everything ever indexed, grows only. Searches that widen can stop once they cover it
+    bool GetExtents(Vec2& min, Vec2& max) const;
+
+    // Entities spanning more cells than this are kept in one list checked by every query
+    static constexpr size_t MAX_CELLS_PER_ENTITY = 64;
+
+private:
+    struct CellRange {
+        int minX = 0;
+        int minY = 0;
+        int maxX = -1;
+        int maxY = -1;
+
+        bool operator==(const CellRange& other) const = default;
+    };
+
+    struct Entry {
+        Vec2 min;
+        Vec2 max;
+        CellRange range;
+        bool oversized = false;
+        uint32_t stamp = 0;
+    };
+
+    float cellSize;
+    std::unordered_map<uint64_t, std::vector<uint32_t>> cells;
+    ComponentPool<Entry> entries;
+    std::vector<uint32_t> oversized;
+    uint32_t queryStamp = 0;
+
+    bool hasExtents = false;
+    Vec2 extentsMin = Vec2::zero();
+    Vec2 extentsMax = Vec2::zero();
+
+    CellRange GetCellRange(const Vec2& min, const Vec2& max) const;
+    static size_t CellCount(const CellRange& range);
+    static uint64_t CellKey(int x, int y)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+    void Link(uint32_t entityID, const Entry& entry);
+    void Unlink(uint32_t entityID, const Entry& entry);
+};
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include "TextureLoader.h"
+#include <SDL3/SDL_log.h>
+#include <SDL3_image/SDL_image.h>
+
+namespace SquareCore
+{
+    TextureLoader::~TextureLoader()
+    {
+        Shutdown();
+    }
+
+    void TextureLoader::Request(const std::string& spritePath)
+    {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+
+        if (stopping || !requested.insert(spritePath).second)
+        {
+            return;
+        }
+
+        requests.push_back(spritePath);
+
+        // The worker is only started once something needs decoding, headless managers never pay for it
+        if (!worker.joinable())
+        {
+            worker = std::thread(&TextureLoader::WorkerLoop, this);
+        }
+        requestCondition.notify_one();
+    }
+
+    std::vector<std::pair<std::string, SDL_Surface*>> TextureLoader::TakeDecoded()
+    {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        std::vector<std::pair<std::string, SDL_Surface*>> result = std::move(decoded);
+        decoded.clear();
+        return result;
+    }
+
+    void TextureLoader::Forget(const std::string& spritePath)
+    {
+        std::lock_guard<std::mutex> lock(loaderMutex);
+        requested.erase(spritePath);
+    }
+
+    void TextureLoader::Shutdown()
+    {
+        {
+            std::lock_guard<std::mutex> lock(loaderMutex);
+            stopping = true;
+        }
+        requestCondition.notify_all();
+
+        if (worker.joinable())
+        {
+            worker.join();
+        }
+
+        for (auto& [path, surface] : decoded)
+        {
+            if (surface)
+            {
+                SDL_DestroySurface(surface);
+            }
+        }
+        decoded.clear();
+    }
+
+    void TextureLoader::WorkerLoop()
+    {
+        while (true)
+        {
+            std::string spritePath;
+            {
+                std::unique_lock<std::mutex> lock(loaderMutex);
+                requestCondition.wait(lock, [this] { return stopping || !requests.empty(); });
+                if (stopping)
+                {
+                    return;
+                }
+                spritePath = std::move(requests.front());
+                requests.pop_front();
+            }
+
+            // Decode without holding the lock so requests keep flowing in
+            SDL_Surface* surface = IMG_Load(spritePath.c_str());
+            if (!surface)
+            {
+                SDL_LogError(SDL_LOG_CATEGORY_ERROR, "Failed to load image %s: %s", spritePath.c_str(), SDL_GetError());
+            }
+
+            std::lock_guard<std::mutex> lock(loaderMutex);
+            decoded.emplace_back(std::move(spritePath), surface);
+        }
+    }
+}
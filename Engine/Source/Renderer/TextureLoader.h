@@ -0,0 +1,46 @@
+#ifndef TEXTURELOADER_H
+#define TEXTURELOADER_H
+
+#include <SDL3/SDL.h>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace SquareCore {
+
+// Decodes sprite images on a background thread. Decoded surfaces are handed back to the caller,
+// which turns them into textures on the thread that owns the SDL renderer
+class TextureLoader {
+public:
+    TextureLoader() = default;
+    ~TextureLoader();
+
+    // Thread-safe function to queue an image for decoding (paths already requested are ignored)
+    void Request(const std::string& spritePath);
+    // Thread-safe function to take every decode finished since the last call (surface is null on failure)
+    std::vector<std::pair<std::string, SDL_Surface*>> TakeDecoded();
+    // Thread-safe function to let a path be requested again, e.g. after its texture was released
+    void Forget(const std::string& spritePath);
+    // Stops the worker thread and frees any surfaces nobody took
+    void Shutdown();
+
+private:
+    void WorkerLoop();
+
+    std::thread worker;
+    std::mutex loaderMutex;
+    std::condition_variable requestCondition;
+    std::deque<std::string> requests;
+    std::unordered_set<std::string> requested;
+    std::vector<std::pair<std::string, SDL_Surface*>> decoded;
+    bool stopping = false;
+};
+
+}
+
+#endif
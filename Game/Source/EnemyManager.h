@@ -38,15 +38,21 @@ public:
     bool final_boss_slash_active = false;
 
 private:
+    void RegisterEnemyPrefabs();
     void AlterChargeEnemy(uint32_t enemy_id);
     void AlterJumpEnemy(uint32_t enemy_id);
+    void AddChargeEnemyProperties(uint32_t enemy_id);
+    void AddJumpEnemyProperties(uint32_t enemy_id);
     void DetermineSecondBossAttack(uint32_t boss_id);
+    bool IsSecondBossGone(int index);
 
 private:
     uint32_t player = 0;
     Player* player_script = nullptr;
     
     std::vector<uint32_t> enemies;
+    uint32_t charge_enemy_prefab = 0;
+    uint32_t jump_enemy_prefab = 0;
     
     std::vector<SquareCore::Vec2> enemy_collider_vertices={
         SquareCore::Vec2(-41.25f, -41.25f),
@@ -72,8 +78,6 @@ private:
     uint32_t jump_boss = 0;
 
     std::array<uint32_t, 3> second_bosses = {};
-    std::array<SecondBoss*, 3> second_boss_properties = {};
-    std::array<Character*, 3> second_boss_ch_properties = {};
     int active_boss = 0;
     SquareCore::Vec2 left_attack_pos = SquareCore::Vec2::zero();
     SquareCore::Vec2 right_attack_pos = SquareCore::Vec2::zero();
@@ -1,4 +1,7 @@
 #include "Application.h"
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
 #include <string>
 #include <iostream>
 
@@ -11,6 +14,27 @@
 #pragma comment(linker, "/SUBSYSTEM:WINDOWS /ENTRY:mainCRTStartup")
 #endif
 
+static void PrintUsage() {
+    std::cout << "Usage: Square [--server | --listen | --client [address]] [--tick-rate hz] [--send-rate hz] [--record file]\n";
+    std::cout << "       Square --replay file [clientID]\n";
+}
+
+// Whole-argument number parsing, false on anything that isn't a finite non-negative number
+static bool ParseFloat(const std::string& value, float& out) {
+    if (value.empty()) return false;
+    char* end = nullptr;
+    float parsed = std::strtof(value.c_str(), &end);
+    if (end != value.c_str() + value.size() || !std::isfinite(parsed) || parsed < 0.0f) return false;
+    out = parsed;
+    return true;
+}
+
+static bool ParseClientID(const std::string& value, uint32_t& out) {
+    const char* end = value.data() + value.size();
+    std::from_chars_result result = std::from_chars(value.data(), end, out);
+    return !value.empty() && result.ec == std::errc() && result.ptr == end;
+}
+
 int main(int argc, char* argv[]) {
     // Square application
     SquareCore::Application app;
@@ -35,6 +59,31 @@ int main(int argc, char* argv[]) {
     app.PushScript(enemy_manager);
     app.PushScript(userInterface);
 
+    // Optional server settings may follow the mode (e.g. --server --tick-rate 128 --send-rate 30 --record session.sqrs)
+    for (int i = 2; i + 1 < argc; ++i) {
+        std::string option = argv[i];
+        if (option == "--tick-rate") {
+            float tick_rate = 0.0f;
+            if (!ParseFloat(argv[++i], tick_rate) || !app.SetTickRate(tick_rate)) {
+                std::cout << "Invalid tick rate: " << argv[i] << "\n";
+                PrintUsage();
+                return 1;
+            }
+        }
+        else if (option == "--send-rate") {
+            float send_rate = 0.0f;
+            if (!ParseFloat(argv[++i], send_rate)) {
+                std::cout << "Invalid send rate: " << argv[i] << "\n";
+                PrintUsage();
+                return 1;
+            }
+            app.SetSendRate(send_rate);
+        }
+        else if (option == "--record") {
+            app.SetSessionRecording(argv[++i]);
+        }
+    }
+
     // Parse command line arguments
     if (argc > 1) {
         std::string arg1 = argv[1];
@@ -48,13 +97,25 @@ int main(int argc, char* argv[]) {
         else if (arg1 == "--client") {
             // Run as client
             std::string serverAddress = "localhost";
-            if (argc > 2) {
+            if (argc > 2 && std::string(argv[2]).rfind("--", 0) != 0) {
                 serverAddress = argv[2];
             }
             std::cout << "Starting Square client, connecting to: " << serverAddress << "\n";
             app.RunClient(serverAddress);
             return 0;
         }
+        else if (arg1 == "--replay" && argc > 2) {
+            // Play back a recorded server session, optionally from one client's point of view
+            uint32_t viewAsClientID = 0;
+            if (argc > 3 && !ParseClientID(argv[3], viewAsClientID)) {
+                std::cout << "Invalid client ID: " << argv[3] << "\n";
+                PrintUsage();
+                return 1;
+            }
+            std::cout << "Starting Square replay of: " << argv[2] << "\n";
+            app.RunReplay(argv[2], viewAsClientID);
+            return 0;
+        }
         else if (arg1 == "--listen") {
             // Run as listen server
             std::cout << "Starting Square listen server...\n";
@@ -63,7 +124,7 @@ int main(int argc, char* argv[]) {
         }
         else {
             std::cout << "Unknown argument: " << arg1 << "\n";
-            std::cout << "Usage: Square [--server | --client [address]]\n";
+            PrintUsage();
             return 1;
         }
     }
@@ -33,20 +33,24 @@ void Map::OnStart()
 void Map::OnUpdate(float deltaTime)
 {
     wormhole_rotation += deltaTime * wormhole_speed;
-    for (int i = 0 ; i < wormholes.size(); i++)
-    {
-        SetRotation(wormholes[i], wormhole_rotation * (1.0f + (i*0.4f)));
-    }
-    for (int i = 0 ; i < wormholes_negative.size(); i++)
-    {
-        SetRotation(wormholes_negative[i], -wormhole_rotation * (1.0f + (i*0.1f)));
-    }
-
     ability_icon_rotation += deltaTime * ability_icon_speed;
-    for (uint32_t icon : ability_icons)
     {
-        if (!EntityExists(icon)) continue;
-        SetRotation(icon, ability_icon_rotation);
+        SquareCore::EntityBatch batch = BatchEntities();
+        for (int i = 0 ; i < wormholes.size(); i++)
+        {
+            if (SquareCore::Entity* wormhole = batch.Get(wormholes[i]))
+                wormhole->rotation = wormhole_rotation * (1.0f + (i*0.4f));
+        }
+        for (int i = 0 ; i < wormholes_negative.size(); i++)
+        {
+            if (SquareCore::Entity* wormhole = batch.Get(wormholes_negative[i]))
+                wormhole->rotation = -wormhole_rotation * (1.0f + (i*0.1f));
+        }
+        for (uint32_t icon : ability_icons)
+        {
+            if (SquareCore::Entity* entity = batch.Get(icon))
+                entity->rotation = ability_icon_rotation;
+        }
     }
 
     /*if (GetKeyPressed(debug_hot_reload))
@@ -65,8 +69,8 @@ void Map::OnUpdate(float deltaTime)
             
             if (EntityHasTag(collision.first, "CrushedEnemyShield"))
             {
-                RemoveEntity(crushed_enemy);
-                RemoveEntity(collision.first);
+                DeferRemoveEntity(crushed_enemy);
+                DeferRemoveEntity(collision.first);
                 player_script->GetPlayerData().the_wall_dead = true;
                 continue;
             }
@@ -80,7 +84,7 @@ void Map::OnUpdate(float deltaTime)
                 SetRotation(level_1_boss_door, 70.0f);
                 SetPosition(level_1_boss_door, -7900.0f, -100.0f);
                 
-                RemoveEntity(ball_entity);
+                DeferRemoveEntity(ball_entity);
                 
                 enemy_manager->SpawnJumpBoss({-11000.0f, 500.0f});
                 enemy_manager->boss_1_active = true;
@@ -89,7 +93,7 @@ void Map::OnUpdate(float deltaTime)
     }
 }
 
-void Map::LoadMap(int level, SquareCore::Vec2 player_position)
+void Map::LoadMap(int level, SquareCore::Vec2 player_position, std::function<void()> on_loaded)
 {
     current_map = level;
     std::string scene_path;
@@ -112,7 +116,18 @@ void Map::LoadMap(int level, SquareCore::Vec2 player_position)
         break;
     }
     
-    LoadScene(scene_path);
+    // The current level keeps playing while the next one loads, the rest runs once it's swapped in. A failed load
+    // still sets up the level so the player is placed and healed as before
+    LoadSceneAsync(scene_path, [this, level, player_position, on_loaded, scene_path](bool loaded)
+    {
+        if (!loaded) SDL_Log("Failed to load scene %s", scene_path.c_str());
+        OnMapLoaded(level, player_position);
+        if (on_loaded) on_loaded();
+    });
+}
+
+void Map::OnMapLoaded(int level, SquareCore::Vec2 player_position)
+{
     if (enemy_manager) enemy_manager->LoadEnemies();
     if (player_script) player_script->TeleportPlayer({player_position.x, player_position.y});
     player_script->UpdateAudioVolumes();
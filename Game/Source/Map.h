@@ -3,6 +3,7 @@
 #include "EnemyManager.h"
 #include "Player.h"
 #include "Script.h"
+#include <functional>
 
 class UserInterface;
 
@@ -11,7 +12,8 @@ class Map : public SquareCore::Script
 public:
     void OnStart() override;
     void OnUpdate(float deltaTime) override;
-    void LoadMap(int level, SquareCore::Vec2 player_position);
+    // Loads a level in the background, on_loaded runs once it has replaced the current one
+    void LoadMap(int level, SquareCore::Vec2 player_position, std::function<void()> on_loaded = nullptr);
     void SetEnemyManager(EnemyManager* enemy_manager) { this->enemy_manager = enemy_manager; }
     void SetPlayerScript(Player* player) { this->player_script = player; }
     void SetUserInterface(UserInterface* ui) { this->ui = ui; }
@@ -22,6 +24,8 @@ public:
     int current_map = 0;
 
 private:
+    void OnMapLoaded(int level, SquareCore::Vec2 player_position);
+
     uint32_t main_menu_music = 0;
     uint32_t level_1_music = 0;
     uint32_t level_2_music = 0;
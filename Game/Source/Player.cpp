@@ -11,7 +11,7 @@ void Player::OnStart()
     AddTagToEntity(player, "Player");
     FlipSprite(player, true, false);
     SetEntityPersistent(player, true);
-    AddPropertyToEntity(player, new Character(player_data.max_health, player_data.health, player_data.damage));
+    AddComponent<Character>(player, player_data.max_health, player_data.health, player_data.damage);
     SetZIndex(player, 1000);
     
     slash_fps = 7.0f / slash_length;
@@ -32,21 +32,32 @@ void Player::OnStart()
     SetZIndex(dash, 1000);
     
     projectile_fps = 100.0f;
-    for (int i = 0; i < 5; i++)
+    SquareCore::Entity projectile_desc;
+    projectile_desc.spritePath = "Resources/Sprites/projectile-sheet.png";
+    projectile_desc.totalFrames = 4;
+    projectile_desc.fps = projectile_fps;
+    projectile_desc.position = SquareCore::Vec2(player_data.x_pos, player_data.y_pos);
+    projectile_desc.scale = SquareCore::Vec2(0.1f, 0.1f);
+    projectile_desc.collider.type = SquareCore::ColliderType::TRIGGER;
+    projectile_desc.shapeData.box.halfExtents = SquareCore::Vec2(50.0f, 25.0f);
+    projectile_desc.isBullet = true;
+    projectile_desc.tags = {"PlayerProjectile"};
+    projectile_desc.visible = false;
+    projectile_desc.persistent = true;
+    projectile_desc.zIndex = -1;
+    std::vector<SquareCore::Entity> projectile_descs(5, projectile_desc);
+    std::vector<uint32_t> projectile_ids = CreateEntityBatch(projectile_descs);
+    // The sheet plays once per shot and holds on its last frame
+    uint32_t projectile_clips = RegisterAnimationClips("projectile", {{"fire", 0, 4, projectile_fps, SquareCore::AnimationLoopMode::ONCE}});
+    for (uint32_t projectile_id : projectile_ids)
     {
+        SetAnimationClips(projectile_id, projectile_clips);
         int slot = projectile_pool.Alloc();
         ProjectileEntity* projectile = static_cast<ProjectileEntity*>(projectile_pool.GetPointer(slot));
-        projectile->id = AddAnimatedEntity("Resources/Sprites/projectile-sheet.png", 4, projectile_fps, player_data.x_pos, player_data.y_pos, 0.0f, 0.1f, 0.1f, false);
+        projectile->id = projectile_id;
         projectile->active = false;
         projectile->timer = 0.0f;
         projectile->direction = Direction::LEFT;
-
-        SetColliderType(projectile->id, SquareCore::ColliderType::TRIGGER);
-        AddTagToEntity(projectile->id, "PlayerProjectile");
-        SetEntityVisible(projectile->id, false);
-        SetEntityPersistent(projectile->id, true);
-        SetColliderBox(projectile->id, 50.0f, 25.0f);
-        SetZIndex(projectile->id, -1);
     }
 
     for (int i = 0; i < slash_audio.size(); i++)
@@ -124,12 +135,9 @@ void Player::TeleportPlayer(const SquareCore::Vec2& position)
 
 void Player::OnExit()
 {
-    for (auto property : GetAllEntityProperties(player))
+    if (Character* cprop = GetComponent<Character>(player))
     {
-        if (Character* cprop = dynamic_cast<Character*>(property))
-        {
-            player_data.health = cprop->health;
-        }
+        player_data.health = cprop->health;
     }
     GameStateManager::SavePlayerData("Saves/S_001.square", player_data);
 }
@@ -166,12 +174,9 @@ void Player::OnUpdate(float delta_time)
             user_interface->AreaTitle("Reginald Bartholomew Pemberton III", "Now Playing:\nRBP3\nCaleb Kronstad");
             
             uint32_t final_boss = GetFirstEntityWithTag("FinalBoss");
-            for (auto& prop : GetAllEntityProperties(final_boss))
+            if (FinalBoss* fb = GetComponent<FinalBoss>(final_boss))
             {
-                if (FinalBoss* fb = dynamic_cast<FinalBoss*>(prop))
-                {
-                    fb->state = FinalBossState::IDLE;
-                }
+                fb->state = FinalBossState::IDLE;
             }
         }
     }
@@ -191,15 +196,6 @@ void Player::OnUpdate(float delta_time)
         ToggleDebugCollisions();*/
     //
 
-    if (!enemies_to_remove.empty())
-    {
-        for (uint32_t enemy : enemies_to_remove)
-        {
-            RemoveEntity(enemy);
-        }
-        enemies_to_remove.clear();
-    }
-
     if (!SquareCore::CompareFloats(bounds[1], target_bounds_y_min))
     {
         float new_y_min = SquareCore::Lerp(bounds[1], target_bounds_y_min, bounds_lerp_speed * delta_time);
@@ -212,12 +208,9 @@ void Player::OnUpdate(float delta_time)
 
 void Player::HealMaxHealth()
 {
-    for (auto& player_property : GetAllEntityProperties(player))
+    if (Character* player_character = GetComponent<Character>(player))
     {
-        if (Character* player_character = dynamic_cast<Character*>(player_property))
-        {
-            player_character->health = player_data.max_health;
-        }
+        player_character->health = player_data.max_health;
     }
     player_data.heals = player_data.max_heals;
 }
@@ -414,17 +407,12 @@ void Player::Heal(float delta_time)
 {
     if (GetKeyPressed(heal_bind) && player_data.heals > 0)
     {
-        for (auto& player_property : GetAllEntityProperties(player))
+        Character* player_character = GetComponent<Character>(player);
+        if (player_character && player_character->health < player_data.max_health)
         {
-            if (Character* player_character = dynamic_cast<Character*>(player_property))
-            {
-                if (player_character->health < player_data.max_health)
-                {
-                    PlayHealSound();
-                    player_character->health = player_data.max_health;
-                    player_data.heals--;
-                }
-            }
+            PlayHealSound();
+            player_character->health = player_data.max_health;
+            player_data.heals--;
         }
     }
 }
@@ -619,70 +607,43 @@ void Player::OnCollision(float delta_time)
             }
 
             bool can_hit = true;
-            JumpEnemy* jump_enemy = nullptr;
-            ChargeEnemy* charge_enemy = nullptr;
-            JumpBoss* jump_boss = nullptr;
-            SecondBoss* second_boss = nullptr;
+            JumpEnemy* jump_enemy = GetComponent<JumpEnemy>(collision.first);
+            ChargeEnemy* charge_enemy = GetComponent<ChargeEnemy>(collision.first);
+            JumpBoss* jump_boss = GetComponent<JumpBoss>(collision.first);
+            SecondBoss* second_boss = GetComponent<SecondBoss>(collision.first);
 
             if (EntityHasTag(collision.first, "EnemyProjectile"))
             {
                 can_hit = true;
             }
     
-            for (auto& enemy_property : GetAllEntityProperties(collision.first))
+            if ((jump_enemy && jump_enemy->hit_player_this_attack) ||
+                (charge_enemy && charge_enemy->hit_player_this_attack) ||
+                (jump_boss && jump_boss->hit_player_this_attack) ||
+                (second_boss && second_boss->hit_player_this_attack))
             {
-                if (JumpEnemy* je = dynamic_cast<JumpEnemy*>(enemy_property))
-                {
-                    jump_enemy = je;
-                    if (jump_enemy->hit_player_this_attack)
-                        can_hit = false;
-                }
-                if (ChargeEnemy* ce = dynamic_cast<ChargeEnemy*>(enemy_property))
-                {
-                    charge_enemy = ce;
-                    if (charge_enemy->hit_player_this_attack)
-                        can_hit = false;
-                }
-                if (JumpBoss* jb = dynamic_cast<JumpBoss*>(enemy_property))
-                {
-                    jump_boss = jb;
-                    if (jump_boss->hit_player_this_attack)
-                        can_hit = false;
-                }
-                if (SecondBoss* sb = dynamic_cast<SecondBoss*>(enemy_property))
-                {
-                    second_boss = sb;
-                    if (sb->hit_player_this_attack)
-                        can_hit = false;
-                }
+                can_hit = false;
             }
     
             if (can_hit)
             {
                 SDL_Log("Dealing damage - can_take_damage before: %d", can_take_damage);
-                for (auto& enemy_property : GetAllEntityProperties(collision.first))
+                Character* enemy_character = GetComponent<Character>(collision.first);
+                Character* player_character = GetComponent<Character>(player);
+                if (enemy_character && player_character)
                 {
-                    if (Character* enemy_character = dynamic_cast<Character*>(enemy_property))
-                    {
-                        for (auto& player_property : GetAllEntityProperties(player))
-                        {
-                            if (Character* player_character = dynamic_cast<Character*>(player_property))
-                            {
-                                if (jump_enemy)
-                                    jump_enemy->hit_player_this_attack = true;
-                                if (charge_enemy)
-                                    charge_enemy->hit_player_this_attack = true;
-                                if (jump_boss)
-                                    jump_boss->hit_player_this_attack = true;
-                                if (second_boss)
-                                    second_boss->hit_player_this_attack = true;
-                        
-                                TakeDamage(player_character, enemy_character->damage);
-                                if (player_character->health <= 0)
-                                    return;
-                            }
-                        }
-                    }
+                    if (jump_enemy)
+                        jump_enemy->hit_player_this_attack = true;
+                    if (charge_enemy)
+                        charge_enemy->hit_player_this_attack = true;
+                    if (jump_boss)
+                        jump_boss->hit_player_this_attack = true;
+                    if (second_boss)
+                        second_boss->hit_player_this_attack = true;
+            
+                    TakeDamage(player_character, enemy_character->damage);
+                    if (player_character->health <= 0)
+                        return;
                 }
             }
         }
@@ -740,14 +701,11 @@ void Player::OnCollision(float delta_time)
 
         if (EntityHasTag(collision.first, "Spike"))
         {
-            for (auto& player_property : GetAllEntityProperties(player))
+            if (Character* player_character = GetComponent<Character>(player))
             {
-                if (Character* player_character = dynamic_cast<Character*>(player_property))
-                {
-                    TakeDamage(player_character, 1);
-                    if (player_character->health <= 0)
-                        return;
-                }
+                TakeDamage(player_character, 1);
+                if (player_character->health <= 0)
+                    return;
             }
             SetVelocity(player, 0.0f, 0.0f);
             SetPosition(player, last_grounded_position.x, last_grounded_position.y);
@@ -773,20 +731,22 @@ void Player::TakeDamage(Character* player_character, int damage)
     player_character->health -= damage;
     SDL_Log(("Player health: " + std::to_string(player_character->health)).c_str());
 
-    if (player_character->health <= 0)
+    // A reload already on its way restores health once it's swapped in
+    if (player_character->health <= 0 && !IsLoadingScene())
     {
         bool was_boss_3_active = enemy_manager->boss_3_active;
     
         int spawn_index = map->current_map > 0 ? map->current_map - 1 : 0;
         last_grounded_position = player_data.spawn_points[spawn_index];
-        map->LoadMap(map->current_map, player_data.spawn_points[spawn_index]);
-    
-        if (was_boss_3_active)
+        map->LoadMap(map->current_map, player_data.spawn_points[spawn_index], [this, was_boss_3_active]
         {
-            dialog_manager->ClearSeenEntry(6);
-            TeleportPlayer({-11880.0, 5375.0});
-            SetCameraPosition(GetPosition(player));
-        }
+            if (was_boss_3_active)
+            {
+                dialog_manager->ClearSeenEntry(6);
+                TeleportPlayer({-11880.0, 5375.0});
+                SetCameraPosition(GetPosition(player));
+            }
+        });
     
         SDL_Log("Player died");
     }
@@ -853,7 +813,7 @@ void Player::DealDamage(Character* enemy_character, uint32_t enemy_id, int damag
         }
         
         SDL_Log(("Enemy : " + std::to_string(enemy_id) + " died").c_str());
-        enemies_to_remove.push_back(enemy_id);
+        DeferRemoveEntity(enemy_id);
     }
 }
 
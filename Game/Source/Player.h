@@ -177,7 +177,6 @@ private:
     bool slash_in_cooldown = false;
 
     std::vector<uint32_t> recently_hit_by_enemies;
-    std::vector<uint32_t> enemies_to_remove;
     std::vector<BounceEntity> recently_bounced_on;
     
     std::vector<uint32_t> trap_walls;
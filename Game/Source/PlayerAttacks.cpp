@@ -108,16 +108,13 @@ void Player::Slash(float delta_time)
             {
                 damaged_by_slash_enemies.push_back(collision.first);
                 
-                for (auto& property : GetAllEntityProperties(collision.first))
+                if (ChargeEnemy* charge_enemy = GetComponent<ChargeEnemy>(collision.first))
                 {
-                    if (ChargeEnemy* charge_enemy = dynamic_cast<ChargeEnemy*>(property))
-                    {
-                        charge_enemy->aware_of_player = true;
-                    }
-                    if (JumpEnemy* jump_enemy = dynamic_cast<JumpEnemy*>(property))
-                    {
-                        jump_enemy->aggro_on_player = true;
-                    }
+                    charge_enemy->aware_of_player = true;
+                }
+                if (JumpEnemy* jump_enemy = GetComponent<JumpEnemy>(collision.first))
+                {
+                    jump_enemy->aggro_on_player = true;
                 }
                 
                 SquareCore::Vec2 enemy_velocity = GetVelocity(collision.first);
@@ -145,12 +142,9 @@ void Player::Slash(float delta_time)
                     SetVelocity(collision.first, enemy_velocity.x + knockback_x, enemy_velocity.y + knockback_y);
                 }
             
-                for (auto& property : GetAllEntityProperties(collision.first))
+                if (Character* health_property = GetComponent<Character>(collision.first))
                 {
-                    if (Character* health_property = dynamic_cast<Character*>(property))
-                    {
-                        DealDamage(health_property, collision.first, slash_damage);
-                    }
+                    DealDamage(health_property, collision.first, slash_damage);
                 }
             }
         }
@@ -202,10 +196,8 @@ void Player::Projectile(float delta_time)
                     spawn_offset.x = -40.0f;
         
                 SetPosition(projectile->id, player_position.x + spawn_offset.x, player_position.y + spawn_offset.y);
-                ResetAnimation(projectile->id);
+                PlayAnimation(projectile->id, "fire", true);
                 FlipSprite(projectile->id, projectile->direction != Direction::RIGHT, false);
-                SetAnimationFPS(projectile->id, projectile_fps);
-                SetAnimationFrame(projectile->id, 0);
                 SetEntityVisible(projectile->id, true);
 
                 float direction = player_direction == Direction::RIGHT ? -1.0f : 1.0f;
@@ -228,13 +220,6 @@ void Player::Projectile(float delta_time)
         else
             SetPosition(projectile->id, current_position.x - movement, current_position.y);
         
-        if (IsAnimationComplete(projectile->id))
-        {
-            int final_frame = GetTotalFrames(projectile->id) - 1;
-            SetAnimationFrame(projectile->id, final_frame);
-            SetAnimationFPS(projectile->id, 0.0f);
-        }
-        
         std::vector<std::pair<uint32_t, int>> collisions = GetEntityCollisions(projectile->id);
         for (const auto& collision : collisions)
         {
@@ -255,16 +240,13 @@ void Player::Projectile(float delta_time)
             }
             if (EntityHasTag(collision.first, "Enemy"))
             {
-                for (auto& property : GetAllEntityProperties(collision.first))
+                if (ChargeEnemy* charge_enemy = GetComponent<ChargeEnemy>(collision.first))
                 {
-                    if (ChargeEnemy* charge_enemy = dynamic_cast<ChargeEnemy*>(property))
-                    {
-                        charge_enemy->aware_of_player = true;
-                    }
-                    if (JumpEnemy* jump_enemy = dynamic_cast<JumpEnemy*>(property))
-                    {
-                        jump_enemy->aggro_on_player = true;
-                    }
+                    charge_enemy->aware_of_player = true;
+                }
+                if (JumpEnemy* jump_enemy = GetComponent<JumpEnemy>(collision.first))
+                {
+                    jump_enemy->aggro_on_player = true;
                 }
                 
                 float knockback_x = (projectile->direction == Direction::RIGHT ? 1.0f : -1.0f) * projectile_knockback;
@@ -273,11 +255,8 @@ void Player::Projectile(float delta_time)
                 if (!EntityHasTag(collision.first, "EnemyProjectile"))
                     SetVelocity(collision.first, knockback_x, knockback_y);
 
-                for (auto& property : GetAllEntityProperties(collision.first))
-                {
-                    if (Character* health_property = dynamic_cast<Character*>(property))
-                        DealDamage(health_property, collision.first, projectile_damage);
-                }
+                if (Character* health_property = GetComponent<Character>(collision.first))
+                    DealDamage(health_property, collision.first, projectile_damage);
             
                 projectile->active = false;
                 SetEntityVisible(projectile->id, false);
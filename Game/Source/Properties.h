@@ -57,7 +57,7 @@ enum class FinalBossAttackType : uint8_t
     SLAM
 };
 
-struct Character : SquareCore::Property
+struct Character
 {
     int max_health = 10;
     int health = 10;
@@ -66,7 +66,7 @@ struct Character : SquareCore::Property
     Character(int max_health = 10, int health = 10, int damage = 1) { this->max_health = max_health; this->health = health; this->damage = damage; }
 };
 
-struct JumpEnemy : SquareCore::Property
+struct JumpEnemy
 {
     JumpEnemyState state = JumpEnemyState::IDLE;
     
@@ -103,7 +103,7 @@ struct JumpEnemy : SquareCore::Property
     }
 };
 
-struct ChargeEnemy : SquareCore::Property
+struct ChargeEnemy
 {
     ChargeEnemyState state = ChargeEnemyState::PATROLLING;
     Direction facing_direction = Direction::RIGHT;
@@ -140,7 +140,7 @@ struct ChargeEnemy : SquareCore::Property
     }
 };
 
-struct JumpBoss : SquareCore::Property
+struct JumpBoss
 {
     float jump_cooldown = 3.0f;
     float jump_cooldown_timer = 0.0f;
@@ -157,7 +157,7 @@ struct JumpBoss : SquareCore::Property
     bool hit_player_this_attack = false;
 };
 
-struct SecondBoss : SquareCore::Property
+struct SecondBoss
 {
     uint32_t id = 0;
     SquareCore::Vec2 spawn_position;
@@ -179,7 +179,7 @@ struct SecondBoss : SquareCore::Property
     }
 };
 
-struct FinalBoss : SquareCore::Property
+struct FinalBoss
 {
     FinalBossState state = FinalBossState::TALKING;
     FinalBossAttackType attack_type = FinalBossAttackType::NONE;
@@ -357,13 +357,9 @@ void UserInterface::UpdateHeals()
 void UserInterface::UpdateHealthBar()
 {
     int currentHealth = 0;
-    for (auto& property : GetAllEntityProperties(player))
+    if (Character* character = GetComponent<Character>(player))
     {
-        if (Character* character = dynamic_cast<Character*>(property))
-        {
-            currentHealth = character->health;
-            break;
-        }
+        currentHealth = character->health;
     }
 
     for (int i = 0; i < healthSquares.size(); i++)
@@ -0,0 +1,488 @@
+#include "Core/Script.h"
+#include "Networking/Client.h"
+#include "Networking/Server.h"
+#include <json/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+
+// Load test configuration
+struct LoadTestConfig
+{
+    int bots = 8;
+    float duration = 30.0f;       // Seconds of measured traffic after all bots connected
+    int npcs = 200;               // Server-side moving entities replicated to every bot
+    std::string input = "random"; // random or script
+    uint32_t budget = 0;          // Snapshot bytes per reply, 0 keeps the server default, "unlimited" turns it off
+    float tickRate = 60.0f;       // Server simulation ticks per second
+    float sendRate = 60.0f;       // Snapshots per second sent to each bot
+    unsigned int seed = 1337;
+    std::string address = "localhost";
+    std::string outputPath;
+    std::string recordPath;       // Session recording of the server, for replaying the run
+};
+
+// Min/mean/max/p95 of a sample series
+struct SeriesStats
+{
+    double min = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+    double p95 = 0.0;
+    double stddev = 0.0;
+};
+
+static SeriesStats ComputeStats(std::vector<double> samples)
+{
+    SeriesStats stats;
+    if (samples.empty()) return stats;
+
+    std::sort(samples.begin(), samples.end());
+    double total = 0.0;
+    for (double sample : samples) {
+        total += sample;
+    }
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.mean = total / static_cast<double>(samples.size());
+    stats.p95 = samples[std::min(samples.size() - 1, static_cast<size_t>(samples.size() * 0.95))];
+
+    double variance = 0.0;
+    for (double sample : samples) {
+        variance += (sample - stats.mean) * (sample - stats.mean);
+    }
+    stats.stddev = std::sqrt(variance / static_cast<double>(samples.size()));
+    return stats;
+}
+
+static nlohmann::json StatsToJson(const SeriesStats& stats)
+{
+    return {
+        {"min", stats.min},
+        {"mean", stats.mean},
+        {"max", stats.max},
+        {"p95", stats.p95},
+        {"stddev", stats.stddev}
+    };
+}
+
+static void PrintUsage()
+{
+    std::cout << "Usage: NetLoadTest [--bots N] [--duration seconds] [--npcs N] [--input random|script]\n"
+              << "                   [--budget bytes|unlimited] [--tick-rate hz] [--send-rate hz] [--seed N]\n"
+              << "                   [--address host] [--output file.json] [--record file]\n";
+}
+
+// Parses a whole argument as a non-negative number, false on anything else
+template<typename T>
+static bool ParseNumber(const std::string& value, T& out)
+{
+    if (value.empty()) return false;
+
+    T parsed{};
+    const char* end = value.data() + value.size();
+    const char* parsedEnd = nullptr;
+    if constexpr (std::is_floating_point_v<T>) {
+        char* floatEnd = nullptr;
+        parsed = static_cast<T>(std::strtod(value.c_str(), &floatEnd));
+        parsedEnd = floatEnd;
+        if (!std::isfinite(parsed)) return false;
+    } else {
+        std::from_chars_result result = std::from_chars(value.data(), end, parsed);
+        if (result.ec != std::errc()) return false;
+        parsedEnd = result.ptr;
+    }
+    if (parsedEnd != end || parsed < 0) return false;
+
+    out = parsed;
+    return true;
+}
+
+static bool ParseArgs(int argc, char* argv[], LoadTestConfig& config)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+
+        std::string value = argv[++i];
+        bool valid = true;
+        if (arg == "--bots") valid = ParseNumber(value, config.bots);
+        else if (arg == "--duration") valid = ParseNumber(value, config.duration) && config.duration > 0.0f;
+        else if (arg == "--npcs") valid = ParseNumber(value, config.npcs);
+        else if (arg == "--input") config.input = value;
+        else if (arg == "--budget") {
+            if (value == "unlimited") config.budget = SquareCore::Server::UNLIMITED_BANDWIDTH;
+            else valid = ParseNumber(value, config.budget);
+        }
+        else if (arg == "--tick-rate") valid = ParseNumber(value, config.tickRate) && config.tickRate > 0.0f;
+        else if (arg == "--send-rate") valid = ParseNumber(value, config.sendRate);
+        else if (arg == "--seed") valid = ParseNumber(value, config.seed);
+        else if (arg == "--address") config.address = value;
+        else if (arg == "--output") config.outputPath = value;
+        else if (arg == "--record") config.recordPath = value;
+        else {
+            std::cout << "Unknown argument: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+
+        if (!valid) {
+            std::cout << "Invalid value for " << arg << ": " << value << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+
+    if (config.input != "random" && config.input != "script") {
+        std::cout << "Unknown input mode: " << config.input << "\n";
+        PrintUsage();
+        return false;
+    }
+    return true;
+}
+
+// Minimal server game: one physics body per client driven by its input, plus wandering NPCs
+class LoadTestScript : public SquareCore::Script
+{
+public:
+    LoadTestScript(int npcCount) : npcCount(npcCount) {}
+
+    void OnStart() override
+    {
+        AddSpritelessEntity(8000.0f, 100.0f, SquareCore::RGBA(0, 0, 0, 255), 0.0f, -50.0f);
+
+        for (int i = 0; i < npcCount; ++i) {
+            float x = -3500.0f + 7000.0f * (static_cast<float>(i) / std::max(1, npcCount));
+            // Dynamic bodies without gravity, so the velocities set each tick actually move them
+            uint32_t npc = AddSpritelessEntity(30.0f, 30.0f, SquareCore::RGBA(255, 0, 0, 255), x, 200.0f + (i % 10) * 60.0f,
+                                               0.0f, 1.0f, 1.0f, true);
+            SetGravityScale(npc, 0.0f);
+            npcs.push_back(npc);
+        }
+    }
+
+    void OnUpdate(float deltaTime) override
+    {
+        elapsed += deltaTime;
+
+        // Connects and disconnects arrive on the server's listener thread
+        std::unordered_map<uint32_t, uint32_t> currentPlayers;
+        {
+            std::lock_guard<std::mutex> lock(playersMutex);
+            currentPlayers = players;
+        }
+
+        for (uint32_t clientID : GetConnectedClients()) {
+            auto it = currentPlayers.find(clientID);
+            if (it == currentPlayers.end()) continue;
+
+            SquareCore::InputState input = GetInputForClient(clientID);
+            SquareCore::Vec2 velocity = GetVelocity(it->second);
+            float moveX = input.axes.count("moveX") ? input.axes["moveX"] : 0.0f;
+            bool jump = input.buttons.count("jump") && input.buttons["jump"];
+            SetVelocity(it->second, moveX * 600.0f, jump ? 800.0f : velocity.y);
+        }
+
+        for (size_t i = 0; i < npcs.size(); ++i) {
+            float phase = elapsed * 1.5f + static_cast<float>(i) * 0.37f;
+            SetVelocity(npcs[i], std::sin(phase) * 300.0f, std::cos(phase) * 150.0f);
+        }
+    }
+
+    void OnClientConnected(uint32_t clientID) override
+    {
+        float x = -2000.0f + static_cast<float>(clientID % 40) * 100.0f;
+        uint32_t player = AddSpritelessEntity(40.0f, 80.0f, SquareCore::RGBA(0, 0, 255, 255), x, 100.0f, 0.0f, 1.0f, 1.0f, true);
+        {
+            std::lock_guard<std::mutex> lock(playersMutex);
+            players[clientID] = player;
+        }
+        RegisterPlayerEntity(clientID, player);
+        BroadcastEntitySpawn(player, clientID);
+    }
+
+    void OnClientDisconnected(uint32_t clientID) override
+    {
+        // The server has already removed the player entity
+        uint32_t player = 0;
+        {
+            std::lock_guard<std::mutex> lock(playersMutex);
+            auto it = players.find(clientID);
+            if (it == players.end()) return;
+            player = it->second;
+            players.erase(it);
+        }
+        BroadcastEntityDespawn(player);
+    }
+
+private:
+    int npcCount;
+    float elapsed = 0.0f;
+    std::vector<uint32_t> npcs;
+    std::unordered_map<uint32_t, uint32_t> players;  // clientID -> player entity, guarded by playersMutex
+    std::mutex playersMutex;
+};
+
+// Samples recorded by one bot, written only by its own thread
+struct BotSamples
+{
+    std::vector<double> roundTripMs;
+    std::vector<double> stateBytes;
+    std::vector<double> interArrivalMs;  // Time between replies carrying a new snapshot
+    uint64_t replies = 0;
+    uint64_t repliesWithoutState = 0;
+    uint64_t bytesReceived = 0;
+    std::chrono::steady_clock::time_point lastArrival;
+    uint64_t lastTimestamp = 0;
+};
+
+// One synthetic player using the real Client code path
+class Bot
+{
+public:
+    Bot(const LoadTestConfig& config, int index) : config(config), index(index), rng(config.seed + index)
+    {
+        client.SetReplyObserver([this](const SquareCore::ClientReplyInfo& info) { Record(info); });
+    }
+
+    bool Connect() { return client.Connect(config.address); }
+
+    void Run(const std::atomic<bool>& recording, const std::atomic<bool>& stop)
+    {
+        std::uniform_real_distribution<float> axisDist(-1.0f, 1.0f);
+        std::uniform_int_distribution<int> holdDist(10, 60);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        float moveX = 0.0f;
+        bool jump = false;
+        int holdFrames = 0;
+
+        while (!stop.load()) {
+            this->recording = recording.load();
+
+            // Random input holds each choice for a while, scripted input walks back and forth and hops
+            if (config.input == "random") {
+                if (--holdFrames <= 0) {
+                    moveX = axisDist(rng);
+                    jump = axisDist(rng) > 0.8f;
+                    holdFrames = holdDist(rng);
+                }
+            } else {
+                float t = std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() + index * 0.25f;
+                moveX = std::sin(t);
+                jump = std::fmod(t, 2.0f) < 0.1f;
+            }
+
+            client.SendInput({{"jump", jump}}, {{"moveX", moveX}});
+            client.Update();
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+
+        client.Disconnect();
+    }
+
+    const BotSamples& GetSamples() const { return samples; }
+    uint32_t GetClientId() const { return clientId; }
+    void StoreClientId() { clientId = client.GetClientId(); }
+
+private:
+    void Record(const SquareCore::ClientReplyInfo& info)
+    {
+        if (!recording) return;
+
+        ++samples.replies;
+        samples.bytesReceived += info.replyBytes;
+        samples.roundTripMs.push_back(info.roundTripMs);
+
+        if (info.stateBytes == 0 || info.stateTimestamp == samples.lastTimestamp) {
+            ++samples.repliesWithoutState;
+            return;
+        }
+
+        std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+        if (samples.lastTimestamp != 0) {
+            samples.interArrivalMs.push_back(std::chrono::duration<double, std::milli>(now - samples.lastArrival).count());
+        }
+        samples.stateBytes.push_back(static_cast<double>(info.stateBytes));
+        samples.lastArrival = now;
+        samples.lastTimestamp = info.stateTimestamp;
+    }
+
+    const LoadTestConfig& config;
+    int index;
+    std::mt19937 rng;
+    SquareCore::Client client;
+    uint32_t clientId = 0;
+    bool recording = false;
+    BotSamples samples;
+};
+
+int main(int argc, char* argv[])
+{
+    LoadTestConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    // Headless server with physics, set up the way Application::RunServer does
+    SquareCore::Server server;
+    LoadTestScript script(config.npcs);
+    std::vector<SquareCore::Script*> scripts = { &script };
+
+    server.GetEntityManager().SetHeadlessMode(true);
+    server.GetEntityManager().SetPhysics(&server.GetPhysics());
+    server.GetPhysics().SetEntityManager(&server.GetEntityManager());
+    server.GetPhysics().Initialize();
+    if (config.budget > 0) {
+        server.SetBandwidthBudget(config.budget);
+    }
+    if (!server.SetTickRate(config.tickRate)) {
+        server.GetPhysics().Shutdown();
+        return 1;
+    }
+    server.SetSendRate(config.sendRate);
+    if (!config.recordPath.empty()) {
+        server.StartRecording(config.recordPath);
+    }
+
+    script.SetEntityManager(&server.GetEntityManager());
+    script.SetPhysicsRef(&server.GetPhysics());
+    script.SetTimeline(&server.GetTimeline());
+    script.SetInputManager(&server.GetInputManager());
+    script.SetMode(SquareCore::NetworkMode::SERVER);
+    script.SetServerRef(&server);
+    script.SetHeadlessServer(true);
+    script.OnStart();
+
+    std::thread serverThread([&server, scripts]() { server.Start(scripts); });
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    // Connect every bot before measuring so the connect burst isn't part of the numbers
+    std::vector<std::unique_ptr<Bot>> bots;
+    for (int i = 0; i < config.bots; ++i) {
+        auto bot = std::make_unique<Bot>(config, i);
+        if (!bot->Connect()) {
+            std::cout << "Bot " << i << " failed to connect\n";
+            continue;
+        }
+        bot->StoreClientId();
+        bots.push_back(std::move(bot));
+    }
+
+    std::atomic<bool> recording{false};
+    std::atomic<bool> stop{false};
+    std::vector<std::thread> botThreads;
+    for (auto& bot : bots) {
+        botThreads.emplace_back(&Bot::Run, bot.get(), std::cref(recording), std::cref(stop));
+    }
+
+    // Let the spawn backlog drain, then measure
+    std::this_thread::sleep_for(std::chrono::seconds(1));
+    SquareCore::ServerTickStats ticksBefore = server.GetTickStats();
+    recording = true;
+    std::this_thread::sleep_for(std::chrono::duration<float>(config.duration));
+    recording = false;
+    SquareCore::ServerTickStats ticksAfter = server.GetTickStats();
+    std::unordered_map<uint32_t, SquareCore::ConnectionStatsSample> serverStats;
+    for (const SquareCore::ConnectionStatsSample& sample : server.GetConnectionStats()) {
+        serverStats[sample.clientID] = sample;
+    }
+
+    stop = true;
+    for (std::thread& thread : botThreads) {
+        thread.join();
+    }
+
+    server.Stop();
+    if (serverThread.joinable()) {
+        serverThread.join();
+    }
+    server.GetPhysics().Shutdown();
+
+    nlohmann::json report;
+    report["config"] = {
+        {"bots", config.bots},
+        {"connected", bots.size()},
+        {"duration", config.duration},
+        {"npcs", config.npcs},
+        {"input", config.input},
+        {"budget", config.budget},
+        {"tickRate", config.tickRate},
+        {"sendRate", config.sendRate},
+        {"seed", config.seed}
+    };
+    report["hardwareThreads"] = std::thread::hardware_concurrency();
+
+    uint64_t ticks = ticksAfter.ticks - ticksBefore.ticks;
+    report["server"] = {
+        {"ticks", ticks},
+        {"ticksPerSecond", ticks / config.duration},
+        {"overruns", ticksAfter.overruns - ticksBefore.overruns},
+        {"maxTickMs", ticksAfter.maxTickMs}
+    };
+
+    std::vector<double> allRoundTrip, allStateBytes, allInterArrival;
+    nlohmann::json clients = nlohmann::json::array();
+    for (auto& bot : bots) {
+        const BotSamples& samples = bot->GetSamples();
+        allRoundTrip.insert(allRoundTrip.end(), samples.roundTripMs.begin(), samples.roundTripMs.end());
+        allStateBytes.insert(allStateBytes.end(), samples.stateBytes.begin(), samples.stateBytes.end());
+        allInterArrival.insert(allInterArrival.end(), samples.interArrivalMs.begin(), samples.interArrivalMs.end());
+
+        const SquareCore::ConnectionStatsSample& serverSide = serverStats[bot->GetClientId()];
+        clients.push_back({
+            {"clientId", bot->GetClientId()},
+            {"serverSnapshotsSkipped", serverSide.snapshotsSkipped},
+            {"serverSnapshotsShared", serverSide.snapshotsSent - serverSide.snapshotsPrioritized},
+            {"serverSnapshotsPrioritized", serverSide.snapshotsPrioritized},
+            {"serverInputsOverwritten", serverSide.inputsOverwritten},
+            {"replies", samples.replies},
+            {"repliesWithoutNewState", samples.repliesWithoutState},
+            {"kibPerSecond", samples.bytesReceived / 1024.0 / config.duration},
+            {"roundTripMs", StatsToJson(ComputeStats(samples.roundTripMs))},
+            {"snapshotBytes", StatsToJson(ComputeStats(samples.stateBytes))},
+            {"interArrivalMs", StatsToJson(ComputeStats(samples.interArrivalMs))}
+        });
+    }
+    report["aggregate"] = {
+        {"roundTripMs", StatsToJson(ComputeStats(allRoundTrip))},
+        {"snapshotBytes", StatsToJson(ComputeStats(allStateBytes))},
+        {"interArrivalMs", StatsToJson(ComputeStats(allInterArrival))}
+    };
+    report["clients"] = clients;
+
+    std::string output = report.dump(4);
+    if (config.outputPath.empty()) {
+        std::cout << output << "\n";
+    } else {
+        std::ofstream file(config.outputPath);
+        if (!file.is_open()) {
+            std::cout << "Failed to open output file " << config.outputPath << "\n";
+            return 1;
+        }
+        file << output << "\n";
+    }
+
+    return 0;
+}
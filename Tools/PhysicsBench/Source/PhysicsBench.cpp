@@ -0,0 +1,405 @@
+#include "Physics/Physics.h"
+#include "Renderer/EntityManager.h"
+#include <json/json.hpp>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+// Global allocation counters so each step can report how often it hit the heap
+static std::atomic<uint64_t> allocationCount{0};
+static std::atomic<uint64_t> allocationBytes{0};
+
+void* operator new(std::size_t size)
+{
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* ptr = std::malloc(size == 0 ? 1 : size)) return ptr;
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+// Box2D allocates through its own allocator rather than operator new, so the world gets a counting one too
+static std::atomic<uint64_t> box2dAllocationCount{0};
+static std::atomic<uint64_t> box2dAllocationBytes{0};
+
+static void* CountingBox2DAlloc(unsigned int size, int alignment)
+{
+    box2dAllocationCount.fetch_add(1, std::memory_order_relaxed);
+    box2dAllocationBytes.fetch_add(size, std::memory_order_relaxed);
+#ifdef _WIN32
+    return _aligned_malloc(size, alignment);
+#else
+    // aligned_alloc needs the size to be a multiple of the alignment
+    size_t rounded = (static_cast<size_t>(size) + alignment - 1) & ~(static_cast<size_t>(alignment) - 1);
+    return std::aligned_alloc(alignment, rounded == 0 ? alignment : rounded);
+#endif
+}
+
+// Newer Box2D versions also pass the size to the free callback, the pack accepts either signature
+template<typename... Ignored>
+static void CountingBox2DFree(void* mem, Ignored...)
+{
+#ifdef _WIN32
+    _aligned_free(mem);
+#else
+    std::free(mem);
+#endif
+}
+
+// Benchmark configuration, all counts are per shape type
+struct BenchConfig
+{
+    int frames = 600;
+    int warmupFrames = 60;
+    int boxes = 500;
+    int circles = 500;
+    int capsules = 250;
+    int polygons = 250;
+    int staticBodies = 200;
+    int sensors = 50;
+    int churn = 0;            // Dynamic bodies removed and respawned every frame
+    unsigned int seed = 1337;
+    std::string outputPath;
+};
+
+// Min/mean/max/p95 of a per-frame series
+struct SeriesStats
+{
+    double min = 0.0;
+    double mean = 0.0;
+    double max = 0.0;
+    double p95 = 0.0;
+    double total = 0.0;
+};
+
+static SeriesStats ComputeStats(std::vector<double> samples)
+{
+    SeriesStats stats;
+    if (samples.empty()) return stats;
+
+    std::sort(samples.begin(), samples.end());
+    for (double sample : samples) {
+        stats.total += sample;
+    }
+    stats.min = samples.front();
+    stats.max = samples.back();
+    stats.mean = stats.total / static_cast<double>(samples.size());
+    stats.p95 = samples[std::min(samples.size() - 1, static_cast<size_t>(samples.size() * 0.95))];
+    return stats;
+}
+
+static nlohmann::json StatsToJson(const SeriesStats& stats)
+{
+    return {
+        {"min", stats.min},
+        {"mean", stats.mean},
+        {"max", stats.max},
+        {"p95", stats.p95},
+        {"total", stats.total}
+    };
+}
+
+static void PrintUsage()
+{
+    std::cout << "Usage: PhysicsBench [--frames N] [--warmup N] [--boxes N] [--circles N] [--capsules N]\n"
+              << "                    [--polygons N] [--static N] [--sensors N] [--churn N] [--seed N]\n"
+              << "                    [--output file.json]\n";
+}
+
+// Parses a whole argument as a non-negative number, false on anything else
+template<typename T>
+static bool ParseCount(const std::string& value, T& out)
+{
+    T parsed{};
+    const char* end = value.data() + value.size();
+    std::from_chars_result result = std::from_chars(value.data(), end, parsed);
+    if (result.ec != std::errc() || result.ptr != end || parsed < 0) return false;
+    out = parsed;
+    return true;
+}
+
+static bool ParseArgs(int argc, char* argv[], BenchConfig& config)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+        if (i + 1 >= argc) {
+            std::cout << "Missing value for " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+
+        std::string value = argv[++i];
+        bool valid = true;
+        if (arg == "--frames") valid = ParseCount(value, config.frames);
+        else if (arg == "--warmup") valid = ParseCount(value, config.warmupFrames);
+        else if (arg == "--boxes") valid = ParseCount(value, config.boxes);
+        else if (arg == "--circles") valid = ParseCount(value, config.circles);
+        else if (arg == "--capsules") valid = ParseCount(value, config.capsules);
+        else if (arg == "--polygons") valid = ParseCount(value, config.polygons);
+        else if (arg == "--static") valid = ParseCount(value, config.staticBodies);
+        else if (arg == "--sensors") valid = ParseCount(value, config.sensors);
+        else if (arg == "--churn") valid = ParseCount(value, config.churn);
+        else if (arg == "--seed") valid = ParseCount(value, config.seed);
+        else if (arg == "--output") config.outputPath = value;
+        else {
+            std::cout << "Unknown argument: " << arg << "\n";
+            PrintUsage();
+            return false;
+        }
+
+        if (!valid) {
+            std::cout << "Invalid value for " << arg << ": " << value << "\n";
+            PrintUsage();
+            return false;
+        }
+    }
+    return true;
+}
+
+// Headless entity manager and physics world populated with the benchmark arena
+class BenchWorld
+{
+public:
+    BenchWorld(const BenchConfig& config) : config(config), rng(config.seed)
+    {
+        entityManager.SetHeadlessMode(true);
+        entityManager.SetPhysics(&physics);
+        physics.SetEntityManager(&entityManager);
+        physics.Initialize();
+    }
+
+    ~BenchWorld()
+    {
+        physics.Shutdown();
+    }
+
+    void Populate()
+    {
+        // Arena floor and walls
+        entityManager.AddSpritelessEntity(arenaWidth + 200.0f, 100.0f, SquareCore::RGBA(0, 0, 0, 255), 0.0f, -50.0f);
+        entityManager.AddSpritelessEntity(100.0f, arenaHeight, SquareCore::RGBA(0, 0, 0, 255), -arenaWidth / 2.0f - 50.0f, arenaHeight / 2.0f);
+        entityManager.AddSpritelessEntity(100.0f, arenaHeight, SquareCore::RGBA(0, 0, 0, 255), arenaWidth / 2.0f + 50.0f, arenaHeight / 2.0f);
+
+        std::uniform_real_distribution<float> xDist(-arenaWidth / 2.0f + 50.0f, arenaWidth / 2.0f - 50.0f);
+        std::uniform_real_distribution<float> yDist(100.0f, arenaHeight * 0.5f);
+        for (int i = 0; i < config.staticBodies; ++i) {
+            entityManager.AddSpritelessEntity(80.0f, 20.0f, SquareCore::RGBA(0, 0, 0, 255), xDist(rng), yDist(rng));
+        }
+
+        for (int i = 0; i < config.sensors; ++i) {
+            uint32_t id = entityManager.AddSpritelessEntity(60.0f, 60.0f, SquareCore::RGBA(0, 0, 0, 255), xDist(rng), yDist(rng));
+            entityManager.SetColliderType(id, SquareCore::ColliderType::TRIGGER);
+        }
+
+        for (int i = 0; i < config.boxes; ++i) SpawnDynamic(SquareCore::ColliderShape::BOX);
+        for (int i = 0; i < config.circles; ++i) SpawnDynamic(SquareCore::ColliderShape::CIRCLE);
+        for (int i = 0; i < config.capsules; ++i) SpawnDynamic(SquareCore::ColliderShape::CAPSULE);
+        for (int i = 0; i < config.polygons; ++i) SpawnDynamic(SquareCore::ColliderShape::POLYGON);
+    }
+
+    // Removes and respawns a slice of the dynamic bodies to exercise body creation/destruction
+    void Churn()
+    {
+        for (int i = 0; i < config.churn && !dynamicBodies.empty(); ++i) {
+            size_t index = churnCursor % dynamicBodies.size();
+            entityManager.RemoveEntity(dynamicBodies[index].first);
+            SquareCore::ColliderShape shape = dynamicBodies[index].second;
+            dynamicBodies.erase(dynamicBodies.begin() + index);
+            SpawnDynamic(shape);
+            ++churnCursor;
+        }
+    }
+
+    SquareCore::Physics& GetPhysics() { return physics; }
+    SquareCore::EntityManager& GetEntityManager() { return entityManager; }
+
+private:
+    void SpawnDynamic(SquareCore::ColliderShape shape)
+    {
+        std::uniform_real_distribution<float> xDist(-arenaWidth / 2.0f + 50.0f, arenaWidth / 2.0f - 50.0f);
+        std::uniform_real_distribution<float> yDist(arenaHeight * 0.5f, arenaHeight);
+
+        uint32_t id = entityManager.AddSpritelessEntity(30.0f, 30.0f, SquareCore::RGBA(255, 255, 255, 255),
+                                                        xDist(rng), yDist(rng), 0.0f, 1.0f, 1.0f, true);
+        switch (shape)
+        {
+        case SquareCore::ColliderShape::CIRCLE:
+            physics.SetColliderCircle(id, 15.0f);
+            break;
+        case SquareCore::ColliderShape::CAPSULE:
+            physics.SetColliderCapsule(id, SquareCore::Vec2(0.0f, -10.0f), SquareCore::Vec2(0.0f, 10.0f), 10.0f);
+            break;
+        case SquareCore::ColliderShape::POLYGON:
+            {
+                std::vector<SquareCore::Vec2> vertices = {
+                    SquareCore::Vec2(-15.0f, -15.0f),
+                    SquareCore::Vec2(15.0f, -15.0f),
+                    SquareCore::Vec2(20.0f, 5.0f),
+                    SquareCore::Vec2(0.0f, 18.0f),
+                    SquareCore::Vec2(-20.0f, 5.0f)
+                };
+                physics.SetColliderPolygon(id, vertices);
+                break;
+            }
+        case SquareCore::ColliderShape::BOX:
+        default:
+            break;
+        }
+        physics.SetFixedRotation(id, false);
+        dynamicBodies.emplace_back(id, shape);
+    }
+
+    const BenchConfig& config;
+    std::mt19937 rng;
+
+    SquareCore::EntityManager entityManager;
+    SquareCore::Physics physics;
+
+    std::vector<std::pair<uint32_t, SquareCore::ColliderShape>> dynamicBodies;
+    size_t churnCursor = 0;
+
+    const float arenaWidth = 6000.0f;
+    const float arenaHeight = 6000.0f;
+};
+
+int main(int argc, char* argv[])
+{
+    BenchConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    const float fixedTimestep = 1.0f / 60.0f;
+
+    // Has to be installed before the world is created
+    b2SetAllocator(CountingBox2DAlloc, CountingBox2DFree);
+
+    BenchWorld world(config);
+    world.Populate();
+
+    SquareCore::Physics& physics = world.GetPhysics();
+    physics.SetProfilingEnabled(true);
+
+    for (int i = 0; i < config.warmupFrames; ++i) {
+        world.Churn();
+        physics.Update(fixedTimestep);
+    }
+
+    std::vector<double> lifecycleMs, syncMs, stepMs, collisionMs, updateMs, allocations, allocatedKiB;
+    std::vector<double> box2dAllocations, box2dAllocatedKiB;
+    lifecycleMs.reserve(config.frames);
+    syncMs.reserve(config.frames);
+    stepMs.reserve(config.frames);
+    collisionMs.reserve(config.frames);
+    updateMs.reserve(config.frames);
+    allocations.reserve(config.frames);
+    allocatedKiB.reserve(config.frames);
+    box2dAllocations.reserve(config.frames);
+    box2dAllocatedKiB.reserve(config.frames);
+
+    for (int i = 0; i < config.frames; ++i) {
+        world.Churn();
+
+        uint64_t allocationsBefore = allocationCount.load(std::memory_order_relaxed);
+        uint64_t bytesBefore = allocationBytes.load(std::memory_order_relaxed);
+        uint64_t box2dAllocationsBefore = box2dAllocationCount.load(std::memory_order_relaxed);
+        uint64_t box2dBytesBefore = box2dAllocationBytes.load(std::memory_order_relaxed);
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        physics.Update(fixedTimestep);
+
+        std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+        uint64_t stepAllocations = allocationCount.load(std::memory_order_relaxed) - allocationsBefore;
+        uint64_t stepBytes = allocationBytes.load(std::memory_order_relaxed) - bytesBefore;
+        uint64_t stepBox2dAllocations = box2dAllocationCount.load(std::memory_order_relaxed) - box2dAllocationsBefore;
+        uint64_t stepBox2dBytes = box2dAllocationBytes.load(std::memory_order_relaxed) - box2dBytesBefore;
+
+        const SquareCore::PhysicsStepProfile& profile = physics.GetLastStepProfile();
+        lifecycleMs.push_back(profile.lifecycleMs);
+        syncMs.push_back(profile.syncMs);
+        stepMs.push_back(profile.stepMs);
+        collisionMs.push_back(profile.collisionMs);
+        updateMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+        allocations.push_back(static_cast<double>(stepAllocations));
+        allocatedKiB.push_back(static_cast<double>(stepBytes) / 1024.0);
+        box2dAllocations.push_back(static_cast<double>(stepBox2dAllocations));
+        box2dAllocatedKiB.push_back(static_cast<double>(stepBox2dBytes) / 1024.0);
+    }
+
+    nlohmann::json report;
+    report["config"] = {
+        {"frames", config.frames},
+        {"warmupFrames", config.warmupFrames},
+        {"boxes", config.boxes},
+        {"circles", config.circles},
+        {"capsules", config.capsules},
+        {"polygons", config.polygons},
+        {"static", config.staticBodies},
+        {"sensors", config.sensors},
+        {"churn", config.churn},
+        {"seed", config.seed}
+    };
+    report["entityCount"] = world.GetEntityManager().GetEntityCount();
+    report["phasesMs"] = {
+        {"bodyLifecycle", StatsToJson(ComputeStats(lifecycleMs))},
+        {"sync", StatsToJson(ComputeStats(syncMs))},
+        {"worldStep", StatsToJson(ComputeStats(stepMs))},
+        {"collisions", StatsToJson(ComputeStats(collisionMs))},
+        {"update", StatsToJson(ComputeStats(updateMs))}
+    };
+    // Engine allocations go through operator new, the world step's through Box2D's allocator
+    report["allocationsPerStep"] = StatsToJson(ComputeStats(allocations));
+    report["allocatedKiBPerStep"] = StatsToJson(ComputeStats(allocatedKiB));
+    report["box2dAllocationsPerStep"] = StatsToJson(ComputeStats(box2dAllocations));
+    report["box2dAllocatedKiBPerStep"] = StatsToJson(ComputeStats(box2dAllocatedKiB));
+
+    std::string output = report.dump(4);
+    if (config.outputPath.empty()) {
+        std::cout << output << "\n";
+    } else {
+        std::ofstream file(config.outputPath);
+        if (!file.is_open()) {
+            std::cout << "Failed to open output file " << config.outputPath << "\n";
+            return 1;
+        }
+        file << output << "\n";
+    }
+
+    return 0;
+}
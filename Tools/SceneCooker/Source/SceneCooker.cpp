@@ -0,0 +1,141 @@
+#include "Core/SceneFormat.h"
+#include <SDL3_image/SDL_image.h>
+#include <filesystem>
+#include <iostream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Cooker configuration
+struct CookerConfig
+{
+    std::vector<std::string> inputs;
+    std::string output;
+    std::string root = ".";
+};
+
+static void PrintUsage()
+{
+    std::cout << "Usage: SceneCooker [--root DIR] [--out FILE] <scene.square | directory>...\n"
+              << "  --root DIR   directory sprite paths are relative to (default: current directory)\n"
+              << "  --out FILE   output path when cooking a single scene (default: next to the input)\n";
+}
+
+static bool ParseArgs(int argc, char* argv[], CookerConfig& config)
+{
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            PrintUsage();
+            return false;
+        }
+        if (arg == "--root" || arg == "--out") {
+            if (i + 1 >= argc) {
+                PrintUsage();
+                return false;
+            }
+            std::string value = argv[++i];
+            if (arg == "--root") config.root = value;
+            else config.output = value;
+            continue;
+        }
+        config.inputs.push_back(arg);
+    }
+
+    if (config.inputs.empty()) {
+        PrintUsage();
+        return false;
+    }
+    return true;
+}
+
+// Expands directories into the .square scenes they contain
+static std::vector<std::filesystem::path> CollectScenes(const std::vector<std::string>& inputs)
+{
+    std::vector<std::filesystem::path> scenes;
+    for (const std::string& input : inputs) {
+        std::filesystem::path path(input);
+        if (std::filesystem::is_directory(path)) {
+            for (const auto& entry : std::filesystem::recursive_directory_iterator(path)) {
+                if (entry.is_regular_file() && entry.path().extension() == ".square") {
+                    scenes.push_back(entry.path());
+                }
+            }
+        } else {
+            scenes.push_back(path);
+        }
+    }
+    return scenes;
+}
+
+// Fills in sprite sheet sizes so loading the scene doesn't have to decode images to size colliders
+static void MeasureSprites(SquareCore::CompiledScene& scene, const std::filesystem::path& root,
+                           std::unordered_map<std::string, SquareCore::SceneSpriteRecord>& sizeCache)
+{
+    for (SquareCore::SceneSpriteRecord& sprite : scene.sprites) {
+        const std::string& spritePath = scene.GetString(sprite.path);
+        auto it = sizeCache.find(spritePath);
+        if (it == sizeCache.end()) {
+            SquareCore::SceneSpriteRecord measured = sprite;
+            std::string fullPath = (root / spritePath).string();
+            SDL_Surface* surface = IMG_Load(fullPath.c_str());
+            if (surface) {
+                measured.width = static_cast<float>(surface->w);
+                measured.height = static_cast<float>(surface->h);
+                SDL_DestroySurface(surface);
+            } else {
+                std::cout << "  warning: could not load " << fullPath << ", size left for the loader\n";
+            }
+            it = sizeCache.emplace(spritePath, measured).first;
+        }
+        sprite.width = it->second.width;
+        sprite.height = it->second.height;
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    CookerConfig config;
+    if (!ParseArgs(argc, argv, config)) {
+        return 1;
+    }
+
+    std::vector<std::filesystem::path> scenes = CollectScenes(config.inputs);
+    if (!config.output.empty() && scenes.size() != 1) {
+        std::cout << "--out needs exactly one input scene\n";
+        return 1;
+    }
+
+    std::unordered_map<std::string, SquareCore::SceneSpriteRecord> sizeCache;
+    int failed = 0;
+
+    for (const std::filesystem::path& scenePath : scenes) {
+        SquareCore::CompiledScene scene;
+        if (!SquareCore::SceneFormat::CompileJson(scenePath.string(), scene)) {
+            std::cout << "Failed to compile " << scenePath.string() << "\n";
+            ++failed;
+            continue;
+        }
+
+        MeasureSprites(scene, config.root, sizeCache);
+
+        std::string outPath = config.output.empty() ? SquareCore::SceneFormat::GetCookedPath(scenePath.string()) : config.output;
+        if (!SquareCore::SceneFormat::WriteBinary(outPath, scene)) {
+            std::cout << "Failed to write " << outPath << "\n";
+            ++failed;
+            continue;
+        }
+
+        std::error_code error;
+        uintmax_t sourceSize = std::filesystem::file_size(scenePath, error);
+        uintmax_t cookedSize = std::filesystem::file_size(outPath, error);
+        std::cout << scenePath.string() << " -> " << outPath << ": "
+                  << scene.entities.size() << " entities, "
+                  << scene.ui.size() << " UI elements, "
+                  << scene.sprites.size() << " sprites, "
+                  << scene.strings.size() << " strings ("
+                  << sourceSize << " -> " << cookedSize << " bytes)\n";
+    }
+
+    return failed == 0 ? 0 : 1;
+}